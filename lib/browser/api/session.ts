@@ -1,5 +1,6 @@
 import { fetchWithSession } from '@electron/internal/browser/api/net-fetch';
 import { addIpcDispatchListeners } from '@electron/internal/browser/ipc-dispatch';
+import { clearPreloadCodeCaches } from '@electron/internal/browser/preload-code-cache';
 import * as deprecate from '@electron/internal/common/deprecate';
 
 import { net } from 'electron/main';
@@ -57,6 +58,29 @@ Session.prototype.setDisplayMediaRequestHandler = function (handler, opts) {
   }, opts);
 };
 
+// Preload code caches are kept by Electron rather than Chromium, so they are
+// cleared alongside Chromium's code caches and storage.
+const { clearCodeCaches, clearData, clearStorageData } = Session.prototype;
+
+Session.prototype.clearCodeCaches = async function (options) {
+  await Promise.all([clearCodeCaches.call(this, options), clearPreloadCodeCaches(this)]);
+};
+
+Session.prototype.clearStorageData = async function (options) {
+  await Promise.all([
+    clearStorageData.call(this, options),
+    !options?.storages && clearPreloadCodeCaches(this, options?.origin ? { origins: [options.origin] } : {})
+  ]);
+};
+
+Session.prototype.clearData = async function (options) {
+  await Promise.all([
+    clearData.call(this, options),
+    (!options?.dataTypes || options.dataTypes.includes('cache')) &&
+      clearPreloadCodeCaches(this, { origins: options?.origins, excludeOrigins: options?.excludeOrigins })
+  ]);
+};
+
 const getPreloadsDeprecated = deprecate.warnOnce('session.getPreloads', 'session.getPreloadScripts');
 Session.prototype.getPreloads = function () {
   getPreloadsDeprecated();
@@ -1,5 +1,6 @@
 import { IpcMainImpl } from '@electron/internal/browser/ipc-main-impl';
 import { MessagePortMain } from '@electron/internal/browser/message-port-main';
+import { SharedRingBuffer } from '@electron/internal/common/shared-ring-buffer';
 
 const { WebFrameMain, fromId, fromFrameToken } = process._linkedBinding('electron_browser_web_frame_main');
 
@@ -42,6 +43,19 @@ WebFrameMain.prototype.postMessage = function (...args) {
   this._postMessage(...args);
 };
 
+WebFrameMain.prototype.createSharedRingBuffer = function (channel, options) {
+  if (typeof channel !== 'string') {
+    throw new TypeError('Missing required channel argument');
+  }
+
+  const capacity = options?.capacity ?? 1024 * 1024;
+  if (!Number.isInteger(capacity)) {
+    throw new TypeError('capacity must be an integer');
+  }
+
+  return new SharedRingBuffer(this._createSharedRingBuffer(channel, capacity));
+};
+
 export default {
   fromId,
   fromFrameToken
@@ -52,24 +52,39 @@ const getIpcEmittersForFrameEvent = (event: Electron.IpcMainEvent | Electron.Ipc
   return cachedIpcEmitters;
 };
 
+const dispatchMessage = (event: Electron.IpcMainEvent | Electron.IpcMainServiceWorkerEvent, channel: string, args: any[]) => {
+  const internal = v8Util.getHiddenValue<boolean>(event, 'internal');
+
+  if (internal) {
+    ipcMainInternal.emit(channel, event, ...args);
+  } else if (event.type === 'frame') {
+    addReplyToEvent(event);
+    event.sender.emit('ipc-message', event, channel, ...args);
+    for (const ipcEmitter of getIpcEmittersForFrameEvent(event)) {
+      ipcEmitter?.emit(channel, event, ...args);
+    }
+  } else if (event.type === 'service-worker') {
+    addServiceWorkerPropertyToEvent(event);
+    getServiceWorkerFromEvent(event)?.ipc.emit(channel, event, ...args);
+  }
+};
+
 /**
  * Listens for IPC dispatch events on `api`.
  */
 export function addIpcDispatchListeners (api: NodeJS.EventEmitter) {
-  api.on('-ipc-message' as any, function (event: Electron.IpcMainEvent | Electron.IpcMainServiceWorkerEvent, channel: string, args: any[]) {
-    const internal = v8Util.getHiddenValue<boolean>(event, 'internal');
+  api.on('-ipc-message' as any, dispatchMessage as any);
 
-    if (internal) {
-      ipcMainInternal.emit(channel, event, ...args);
-    } else if (event.type === 'frame') {
-      addReplyToEvent(event);
-      event.sender.emit('ipc-message', event, channel, ...args);
-      for (const ipcEmitter of getIpcEmittersForFrameEvent(event)) {
-        ipcEmitter?.emit(channel, event, ...args);
+  // Messages sent with ipcRenderer.sendBatched arrive together. A listener
+  // that throws must not keep the rest of the batch from being delivered, so
+  // its error is rethrown once the batch has been dispatched.
+  api.on('-ipc-message-batch' as any, function (event: Electron.IpcMainEvent | Electron.IpcMainServiceWorkerEvent, channels: string[], args: any[][]) {
+    for (let i = 0; i < channels.length; i++) {
+      try {
+        dispatchMessage(event, channels[i], args[i]);
+      } catch (error) {
+        process.nextTick(() => { throw error; });
       }
-    } else if (event.type === 'service-worker') {
-      addServiceWorkerPropertyToEvent(event);
-      getServiceWorkerFromEvent(event)?.ipc.emit(channel, event, ...args);
     }
   } as any);
 
@@ -0,0 +1,138 @@
+import { Worker } from 'worker_threads';
+
+// Runs in the worker thread: loads the handler module and answers the
+// invocations posted by IpcHandlerWorker.
+const workerSource = `
+const { parentPort, workerData } = require('node:worker_threads');
+const { pathToFileURL } = require('node:url');
+
+const loadHandler = import(pathToFileURL(workerData.modulePath).href).then(({ default: handler }) => {
+  if (typeof handler !== 'function') {
+    throw new TypeError(\`Expected '\${workerData.modulePath}' to export a function, but found type '\${typeof handler}'\`);
+  }
+  return handler;
+});
+// Reported to each invocation instead.
+loadHandler.catch(() => {});
+
+parentPort.on('message', async ({ id, event, args }) => {
+  try {
+    const handler = await loadHandler;
+    parentPort.postMessage({ id, result: await handler(event, ...args) });
+  } catch (error) {
+    parentPort.postMessage({ id, failed: true, error });
+  }
+});
+`;
+
+type InvokeEvent = Electron.IpcMainInvokeEvent | Electron.IpcMainServiceWorkerInvokeEvent;
+
+type PendingInvoke = {
+  resolve: (result: any) => void;
+  reject: (error: any) => void;
+};
+
+// The event object can't leave the main thread, so the handler gets a plain
+// object that describes the sender instead.
+const getWorkerEvent = (event: InvokeEvent) => {
+  if (event.type === 'service-worker') {
+    return { type: event.type, versionId: event.versionId };
+  }
+  return {
+    type: event.type,
+    processId: event.processId,
+    frameId: event.frameId,
+    url: event.senderFrame?.url
+  };
+};
+
+/**
+ * A worker thread that runs the invoke handler exported by a module, shared by
+ * all the channels that use that module. It is started when the first channel
+ * is registered and is restarted on the next invocation if it exits.
+ */
+export class IpcHandlerWorker {
+  private static workers: Map<string, IpcHandlerWorker> = new Map();
+
+  private worker: Worker | null = null;
+  private pending: Map<number, PendingInvoke> = new Map();
+  private nextId = 0;
+  private refCount = 0;
+
+  private constructor (private modulePath: string) {}
+
+  static acquire (modulePath: string) {
+    let handlerWorker = IpcHandlerWorker.workers.get(modulePath);
+    if (!handlerWorker) {
+      handlerWorker = new IpcHandlerWorker(modulePath);
+      IpcHandlerWorker.workers.set(modulePath, handlerWorker);
+    }
+    handlerWorker.refCount++;
+    handlerWorker.getWorker();
+    return handlerWorker;
+  }
+
+  release () {
+    if (--this.refCount > 0) return;
+    IpcHandlerWorker.workers.delete(this.modulePath);
+    if (this.worker) {
+      this.worker.terminate();
+      this.worker = null;
+    }
+    this.rejectPending(new Error(`Handler for '${this.modulePath}' was removed`));
+  }
+
+  invoke (event: InvokeEvent, args: any[]): Promise<any> {
+    const worker = this.getWorker();
+    const id = this.nextId++;
+    return new Promise((resolve, reject) => {
+      this.pending.set(id, { resolve, reject });
+      try {
+        worker.postMessage({ id, event: getWorkerEvent(event), args });
+      } catch (error) {
+        this.pending.delete(id);
+        reject(error);
+      }
+    });
+  }
+
+  private getWorker () {
+    if (this.worker) return this.worker;
+
+    const worker = new Worker(workerSource, {
+      eval: true,
+      workerData: { modulePath: this.modulePath }
+    });
+    // The app's lifetime isn't tied to its handler workers.
+    worker.unref();
+    worker.on('message', ({ id, result, failed, error }) => {
+      const pending = this.pending.get(id);
+      if (!pending) return;
+      this.pending.delete(id);
+      if (failed) {
+        pending.reject(error);
+      } else {
+        pending.resolve(result);
+      }
+    });
+    worker.on('error', (error) => {
+      console.error(`Error occurred in handler worker for '${this.modulePath}':`, error);
+    });
+    worker.on('exit', (exitCode) => {
+      if (this.worker !== worker) return;
+      this.worker = null;
+      this.rejectPending(new Error(`Handler worker for '${this.modulePath}' exited with code ${exitCode}`));
+    });
+
+    this.worker = worker;
+    return worker;
+  }
+
+  private rejectPending (error: Error) {
+    const pending = [...this.pending.values()];
+    this.pending.clear();
+    for (const { reject } of pending) {
+      reject(error);
+    }
+  }
+}
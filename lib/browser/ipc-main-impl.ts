@@ -1,9 +1,13 @@
+import { IpcHandlerWorker } from '@electron/internal/browser/ipc-handler-worker';
+
 import { IpcMainInvokeEvent } from 'electron/main';
 
 import { EventEmitter } from 'events';
+import * as path from 'path';
 
 export class IpcMainImpl extends EventEmitter implements Electron.IpcMain {
   private _invokeHandlers: Map<string, (e: IpcMainInvokeEvent, ...args: any[]) => void> = new Map();
+  private _workerHandlers: Map<string, IpcHandlerWorker> = new Map();
 
   constructor () {
     super();
@@ -29,7 +33,21 @@ export class IpcMainImpl extends EventEmitter implements Electron.IpcMain {
     });
   };
 
+  handleInWorker: Electron.IpcMain['handleInWorker'] = (method, modulePath) => {
+    if (this._invokeHandlers.has(method)) {
+      throw new Error(`Attempted to register a second handler for '${method}'`);
+    }
+    if (typeof modulePath !== 'string' || !path.isAbsolute(modulePath)) {
+      throw new TypeError('Expected modulePath to be an absolute path');
+    }
+    const worker = IpcHandlerWorker.acquire(modulePath);
+    this._invokeHandlers.set(method, (e, ...args) => worker.invoke(e, args));
+    this._workerHandlers.set(method, worker);
+  };
+
   removeHandler (method: string) {
     this._invokeHandlers.delete(method);
+    this._workerHandlers.get(method)?.release();
+    this._workerHandlers.delete(method);
   }
 }
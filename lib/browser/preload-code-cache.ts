@@ -0,0 +1,171 @@
+import * as crypto from 'crypto';
+import * as fs from 'fs';
+import * as path from 'path';
+
+// V8 code caches for preload scripts. A renderer that had to compile a
+// preload sends back the cache it produced, and later renderers receive it
+// along with the preload so that they can skip parsing and compiling it.
+//
+// Caches are kept per session and per origin, so that a renderer can only
+// affect the caches handed to renderers of its own origin, and are persisted
+// in the session's storage so that they survive restarts. The directory on
+// disk is bounded, and is cleared together with the session's code caches.
+
+// Caches larger than this are dropped rather than sent over IPC.
+const kMaxCodeCacheSize = 64 * 1024 * 1024;
+// Number of caches kept in memory per session.
+const kMaxCachedEntries = 256;
+// Bounds of the caches kept on disk per session. The least recently used
+// caches are evicted first.
+const kMaxDiskEntries = 256;
+const kMaxDiskSize = 128 * 1024 * 1024;
+
+const codeCaches = new WeakMap<Electron.Session, Map<string, Promise<Buffer | undefined>>>();
+
+// Disk operations of a session run one after the other, so that evicting or
+// clearing never races with a write.
+const diskQueues = new WeakMap<Electron.Session, Promise<void>>();
+
+const getSessionCaches = (session: Electron.Session) => {
+  let caches = codeCaches.get(session);
+  if (!caches) {
+    caches = new Map();
+    codeCaches.set(session, caches);
+  }
+  return caches;
+};
+
+const setSessionCache = (session: Electron.Session, key: string, cache: Promise<Buffer | undefined>) => {
+  const caches = getSessionCaches(session);
+  caches.delete(key);
+  if (caches.size >= kMaxCachedEntries) {
+    caches.delete(caches.keys().next().value!);
+  }
+  caches.set(key, cache);
+};
+
+const queueDiskOperation = (session: Electron.Session, operation: () => Promise<void>) => {
+  const queued = (diskQueues.get(session) ?? Promise.resolve()).then(operation).catch(() => {});
+  diskQueues.set(session, queued);
+  return queued;
+};
+
+const hashString = (value: string) => crypto.createHash('sha256').update(value).digest('hex');
+
+// Keys start with the hash of the origin, so that the caches of an origin can
+// be found on disk without knowing its preloads.
+const getOriginPrefix = (origin: string) => `${hashString(origin).slice(0, 32)}-`;
+
+const getCacheKey = (origin: string, sourceHash: string) => `${getOriginPrefix(origin)}${sourceHash}`;
+
+const getRootDirectory = (session: Electron.Session) => {
+  return session.storagePath ? path.join(session.storagePath, 'Preload Code Cache') : null;
+};
+
+// Code caches are only valid for the V8 version that produced them, so each
+// version gets its own directory.
+const getCacheDirectory = (session: Electron.Session) => {
+  const root = getRootDirectory(session);
+  return root ? path.join(root, process.versions.v8) : null;
+};
+
+// Removes the caches written by other V8 versions, and evicts the least
+// recently used caches of this one until the directory fits its bounds.
+const trimDiskCache = async (session: Electron.Session) => {
+  const root = getRootDirectory(session);
+  const dir = getCacheDirectory(session);
+  if (!root || !dir) return;
+
+  for (const version of await fs.promises.readdir(root)) {
+    if (version !== process.versions.v8) {
+      await fs.promises.rm(path.join(root, version), { force: true, recursive: true });
+    }
+  }
+
+  const entries = (await Promise.all((await fs.promises.readdir(dir)).map(async name => {
+    const stats = await fs.promises.stat(path.join(dir, name)).catch(() => null);
+    return stats && { name, mtimeMs: stats.mtimeMs, size: stats.size };
+  }))).filter(entry => entry !== null);
+  entries.sort((a, b) => b.mtimeMs - a.mtimeMs);
+
+  let count = 0;
+  let totalSize = 0;
+  for (const { name, size } of entries) {
+    if (count < kMaxDiskEntries && totalSize + size <= kMaxDiskSize) {
+      count++;
+      totalSize += size;
+      continue;
+    }
+    getSessionCaches(session).delete(name);
+    await fs.promises.rm(path.join(dir, name), { force: true });
+  }
+};
+
+export const getPreloadSourceHash = (contents: string) => hashString(contents);
+
+export const getPreloadCodeCache = (session: Electron.Session, origin: string, sourceHash: string): Promise<Buffer | undefined> => {
+  const key = getCacheKey(origin, sourceHash);
+  const dir = getCacheDirectory(session);
+
+  // Using a cache counts as a use for eviction.
+  const touch = (cache: Buffer | undefined) => {
+    if (cache && dir) {
+      const now = new Date();
+      fs.promises.utimes(path.join(dir, key), now, now).catch(() => {});
+    }
+    return cache;
+  };
+
+  const cached = getSessionCaches(session).get(key);
+  if (cached) return cached.then(touch);
+
+  const cache = dir ? fs.promises.readFile(path.join(dir, key)).then(touch, () => undefined) : Promise.resolve(undefined);
+  setSessionCache(session, key, cache);
+  return cache;
+};
+
+export const setPreloadCodeCache = (session: Electron.Session, origin: string, sourceHash: string, cachedData: unknown) => {
+  if (!(cachedData instanceof Uint8Array) || cachedData.byteLength > kMaxCodeCacheSize) return;
+
+  const key = getCacheKey(origin, sourceHash);
+  const data = Buffer.from(cachedData);
+  setSessionCache(session, key, Promise.resolve(data));
+
+  const dir = getCacheDirectory(session);
+  if (dir) {
+    queueDiskOperation(session, async () => {
+      await fs.promises.mkdir(dir, { recursive: true });
+      await fs.promises.writeFile(path.join(dir, key), data);
+      await trimDiskCache(session);
+    });
+  }
+};
+
+// Clears the caches of |origins|, or of every origin but |excludeOrigins|, or
+// all of them when neither is given.
+export const clearPreloadCodeCaches = (session: Electron.Session, options: { origins?: string[], excludeOrigins?: string[] } = {}) => {
+  const included = options.origins?.map(getOriginPrefix);
+  const excluded = options.excludeOrigins?.map(getOriginPrefix) ?? [];
+  const shouldClear = (key: string) => {
+    if (included) return included.some(prefix => key.startsWith(prefix));
+    return !excluded.some(prefix => key.startsWith(prefix));
+  };
+
+  for (const key of [...getSessionCaches(session).keys()]) {
+    if (shouldClear(key)) getSessionCaches(session).delete(key);
+  }
+
+  const root = getRootDirectory(session);
+  const dir = getCacheDirectory(session);
+  if (!root || !dir) return Promise.resolve();
+
+  return queueDiskOperation(session, async () => {
+    if (!included && excluded.length === 0) {
+      await fs.promises.rm(root, { force: true, recursive: true });
+      return;
+    }
+    for (const name of await fs.promises.readdir(dir)) {
+      if (shouldClear(name)) await fs.promises.rm(path.join(dir, name), { force: true });
+    }
+  });
+};
@@ -1,5 +1,6 @@
 import { ipcMainInternal } from '@electron/internal/browser/ipc-main-internal';
 import * as ipcMainUtils from '@electron/internal/browser/ipc-main-internal-utils';
+import { getPreloadCodeCache, getPreloadSourceHash, setPreloadCodeCache } from '@electron/internal/browser/preload-code-cache';
 import { IPC_MESSAGES } from '@electron/internal/common/ipc-messages';
 
 import { clipboard } from 'electron/common';
@@ -69,11 +70,63 @@ const getPreloadScriptsFromEvent = (event: ElectronInternal.IpcMainInternalEvent
   return preloadScripts.filter(script => path.isAbsolute(script.filePath));
 };
 
-const readPreloadScript = async function (script: Electron.PreloadScript): Promise<ElectronInternal.PreloadScript> {
+interface PreloadScriptContents {
+  contents: string;
+  sourceHash: string;
+}
+
+interface CachedPreloadScript {
+  mtimeMs: number;
+  size: number;
+  data: Promise<PreloadScriptContents>;
+}
+
+// Preload contents keyed by path. An entry is reused for as long as the file's
+// modification time and size are unchanged, so that frames created together
+// share a single read instead of each reading the file again.
+const preloadScriptCache = new Map<string, CachedPreloadScript>();
+
+const readPreloadScriptContents = async function (filePath: string): Promise<PreloadScriptContents> {
+  const { mtimeMs, size } = await fs.promises.stat(filePath);
+  const cached = preloadScriptCache.get(filePath);
+  if (cached && cached.mtimeMs === mtimeMs && cached.size === size) {
+    return cached.data;
+  }
+
+  const data = fs.promises.readFile(filePath, 'utf8').then(contents => ({
+    contents,
+    sourceHash: getPreloadSourceHash(contents)
+  }));
+  preloadScriptCache.set(filePath, { mtimeMs, size, data });
+  data.catch(() => {
+    if (preloadScriptCache.get(filePath)?.data === data) {
+      preloadScriptCache.delete(filePath);
+    }
+  });
+  return data;
+};
+
+// Code caches are shared between frames of the same origin only. Opaque
+// origins and service workers don't use them.
+const getCodeCacheOrigin = (event: ElectronInternal.IpcMainInternalEvent) => {
+  if (event.type !== 'frame') return null;
+  const origin = event.senderFrame?.origin;
+  return origin && origin !== 'null' ? origin : null;
+};
+
+const readPreloadScript = async function (event: ElectronInternal.IpcMainInternalEvent, script: Electron.PreloadScript): Promise<ElectronInternal.PreloadScript> {
   let contents;
+  let sourceHash;
+  let cachedData;
   let error;
   try {
-    contents = await fs.promises.readFile(script.filePath, 'utf8');
+    ({ contents, sourceHash } = await readPreloadScriptContents(script.filePath));
+    const origin = getCodeCacheOrigin(event);
+    if (origin && event.type === 'frame') {
+      cachedData = await getPreloadCodeCache(event.sender.session, origin, sourceHash);
+    } else {
+      sourceHash = undefined;
+    }
   } catch (err) {
     if (err instanceof Error) {
       error = err;
@@ -82,14 +135,44 @@ const readPreloadScript = async function (script: Electron.PreloadScript): Promi
   return {
     ...script,
     contents,
+    sourceHash,
+    cachedData,
     error
   };
 };
 
+// Frame IDs don't change for the lifetime of a document, so lookups of them
+// can be answered by the renderer's own cache.
+const getFrameIdSyncCacheEntries = (frame: Electron.WebFrameMain): ElectronInternal.SyncCacheEntry[] => [
+  [IPC_MESSAGES.BROWSER_GET_FRAME_ROUTING_ID_SYNC, [frame.frameToken], frame.routingId],
+  [IPC_MESSAGES.BROWSER_GET_FRAME_TOKEN_SYNC, [frame.routingId], frame.frameToken]
+];
+
+// Returns the sync cache entries for a renderer that is loading, and sends the
+// new frame's entries to its parent. Lookups are limited to frames in the
+// sender's process, so only those frames are included.
+const getSyncCacheForLoad = (event: ElectronInternal.IpcMainInternalEvent): ElectronInternal.SyncCacheEntry[] => {
+  if (event.type !== 'frame') return [];
+  const frame = event.senderFrame;
+  if (!frame || frame.isDestroyed()) return [];
+
+  const frames = new Set([frame, frame.parent, frame.top].filter(f => {
+    return f && !f.isDestroyed() && f.processId === frame.processId;
+  }) as Electron.WebFrameMain[]);
+
+  const { parent } = frame;
+  if (parent && frames.has(parent)) {
+    parent._sendInternal(IPC_MESSAGES.RENDERER_SYNC_CACHE_UPDATE, getFrameIdSyncCacheEntries(frame));
+  }
+
+  return [...frames].flatMap(getFrameIdSyncCacheEntries);
+};
+
 ipcMainUtils.handleSync(IPC_MESSAGES.BROWSER_SANDBOX_LOAD, async function (event) {
   const preloadScripts = getPreloadScriptsFromEvent(event);
   return {
-    preloadScripts: await Promise.all(preloadScripts.map(readPreloadScript)),
+    preloadScripts: await Promise.all(preloadScripts.map(script => readPreloadScript(event, script))),
+    syncCache: getSyncCacheForLoad(event),
     process: {
       arch: process.arch,
       platform: process.platform,
@@ -101,9 +184,31 @@ ipcMainUtils.handleSync(IPC_MESSAGES.BROWSER_SANDBOX_LOAD, async function (event
   };
 });
 
+ipcMainInternal.on(IPC_MESSAGES.BROWSER_PRELOAD_CODE_CACHE, async function (event, filePath: string, sourceHash: string, consumed: boolean, cachedData?: Uint8Array) {
+  const origin = getCodeCacheOrigin(event);
+  if (!origin || event.type !== 'frame') return;
+
+  // Tells specs whether the renderer used the cache it was given.
+  event.sender.emit('-preload-code-cache', filePath, { consumed: !!consumed, produced: !!cachedData });
+
+  const cached = preloadScriptCache.get(filePath);
+  if (!cachedData || !cached) return;
+
+  // Only accept caches for the current contents of a known preload.
+  try {
+    if ((await cached.data).sourceHash !== sourceHash) return;
+  } catch {
+    return;
+  }
+  setPreloadCodeCache(event.sender.session, origin, sourceHash, cachedData);
+});
+
 ipcMainUtils.handleSync(IPC_MESSAGES.BROWSER_NONSANDBOX_LOAD, function (event) {
   const preloadScripts = getPreloadScriptsFromEvent(event);
-  return { preloadPaths: preloadScripts.map(script => script.filePath) };
+  return {
+    preloadPaths: preloadScripts.map(script => script.filePath),
+    syncCache: getSyncCacheForLoad(event)
+  };
 });
 
 ipcMainInternal.on(IPC_MESSAGES.BROWSER_PRELOAD_ERROR, function (event, preloadPath: string, error: Error) {
@@ -0,0 +1,28 @@
+import { EventEmitter } from 'events';
+
+export class SharedRingBuffer extends EventEmitter implements Electron.SharedRingBuffer {
+  _internalRing: any;
+  constructor (internalRing: any) {
+    super();
+    this._internalRing = internalRing;
+    this._internalRing.emit = (channel: string) => {
+      this.emit(channel);
+    };
+  }
+
+  get capacity (): number {
+    return this._internalRing.capacity;
+  }
+
+  write (data: ArrayBuffer | ArrayBufferView) {
+    return this._internalRing.write(data);
+  }
+
+  read (): Uint8Array | null {
+    return this._internalRing.read();
+  }
+
+  close () {
+    this._internalRing.close();
+  }
+}
@@ -123,6 +123,44 @@ const fileTypeToMode = new Map<AsarFileType, number>([
   [AsarFileType.kLink, constants.S_IFLNK]
 ]);
 
+// Number of values archive.statBatch() packs for each path.
+const kStatBatchStride = 3;
+
+// Types of archive entries, keyed by archive and then by directory. A
+// directory is filled with a single readdir() and statBatch() the first time
+// any entry in it is looked up, so module resolution probing many candidate
+// paths in the same directory only crosses into the archive once.
+const entryTypeCache = new WeakMap<NodeJS.AsarArchive, Map<string, Map<string, AsarFileType> | null>>();
+
+const getCachedEntryType = (archive: NodeJS.AsarArchive, filePath: string): AsarFileType | undefined => {
+  if (filePath === '') return AsarFileType.kDirectory;
+
+  let directories = entryTypeCache.get(archive);
+  if (!directories) {
+    directories = new Map();
+    entryTypeCache.set(archive, directories);
+  }
+
+  const dirPath = path.dirname(filePath);
+  let types = directories.get(dirPath);
+  if (types === undefined) {
+    types = null;
+    const archiveDirPath = dirPath === '.' ? '' : dirPath;
+    const names = archive.readdir(archiveDirPath);
+    const stats = names && archive.statBatch(names.map(name => path.join(archiveDirPath, name)));
+    if (names && stats) {
+      types = new Map();
+      for (let i = 0; i < names.length; i++) {
+        const type = stats[i * kStatBatchStride];
+        if (type >= 0) types.set(names[i], type);
+      }
+    }
+    directories.set(dirPath, types);
+  }
+
+  return types?.get(path.basename(filePath));
+};
+
 const asarStatsToFsStats = function (stats: NodeJS.AsarFileStat) {
   const { Stats } = require('fs');
 
@@ -264,6 +302,22 @@ function validateBufferIntegrity (buffer: Buffer, integrity: NodeJS.AsarFileInfo
   }
 }
 
+// Reads a packed file from the archive's memory mapping. The native side
+// validates integrity and decodes UTF-8 directly, avoiding an intermediate
+// Buffer. Returns false when the mapping can't be used.
+const readMappedFile = (archive: NodeJS.AsarArchive, filePath: string, encoding?: BufferEncoding | null) => {
+  const utf8 = encoding === 'utf8' || encoding === 'utf-8';
+  const contents = archive.read(filePath, utf8);
+  if (contents === false || typeof contents === 'string') return contents;
+  return encoding ? contents.toString(encoding) : contents;
+};
+
+// Async reads of files up to this size are served from the mapping, which is
+// cheaper than a round trip through the thread pool. Larger files are read on
+// the thread pool, so that paging them in and hashing them doesn't block the
+// event loop.
+const kMaxMappedAsyncReadSize = 64 * 1024;
+
 const makePromiseFunction = function (orig: Function, pathArgumentIndex: number) {
   return function (this: any, ...args: any[]) {
     const pathArgument = args[pathArgumentIndex];
@@ -307,6 +361,20 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
     return true;
   };
 
+  // Builds the dirents of an archive directory, stat'ing all children with a
+  // single call. Returns the first child that could not be stat'ed on failure.
+  const getArchiveDirents = (archive: NodeJS.AsarArchive, dirPath: string, names: string[]) => {
+    const childPaths = names.map(name => path.join(dirPath, name));
+    const stats = archive.statBatch(childPaths);
+    const dirents: Dirent[] = [];
+    for (let i = 0; i < names.length; i++) {
+      const type = stats ? stats[i * kStatBatchStride] : -1;
+      if (type < 0) return { missing: childPaths[i] };
+      dirents.push(new fs.Dirent(names[i], type));
+    }
+    return { dirents };
+  };
+
   const { lstatSync } = fs;
   fs.lstatSync = (pathArgument: string, options: any) => {
     const pathInfo = splitPath(pathArgument);
@@ -637,6 +705,15 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
         return fs.readFile(realPath, options, callback);
       }
 
+      logASARAccess(asarPath, filePath, info.offset);
+      if (info.size <= kMaxMappedAsyncReadSize) {
+        const contents = readMappedFile(archive, filePath, encoding);
+        if (contents !== false) {
+          nextTick(callback, [null, contents]);
+          return;
+        }
+      }
+
       const buffer = Buffer.alloc(info.size);
       const fd = archive.getFdAndValidateIntegrityLater();
       if (!(fd >= 0)) {
@@ -645,7 +722,6 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
         return;
       }
 
-      logASARAccess(asarPath, filePath, info.offset);
       fs.read(fd, buffer, 0, info.size, info.offset, (error: Error) => {
         validateBufferIntegrity(buffer, info.integrity);
         callback(error, encoding ? buffer.toString(encoding) : buffer);
@@ -701,13 +777,16 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
     }
 
     const { encoding } = options;
+    logASARAccess(asarPath, filePath, info.offset);
+    const contents = readMappedFile(archive, filePath, encoding);
+    if (contents !== false) return contents;
+
     const buffer = Buffer.alloc(info.size);
     const fd = archive.getFdAndValidateIntegrityLater();
     if (!(fd >= 0)) {
       throw createError(AsarError.NOT_FOUND, { asarPath, filePath });
     }
 
-    logASARAccess(asarPath, filePath, info.offset);
     fs.readSync(fd, buffer, 0, info.size, info.offset);
     validateBufferIntegrity(buffer, info.integrity);
     return (encoding) ? buffer.toString(encoding) : buffer;
@@ -890,16 +969,11 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
     }
 
     if (options?.withFileTypes) {
-      const dirents = [];
-      for (const file of files) {
-        const childPath = path.join(filePath, file);
-        const stats = archive.stat(childPath);
-        if (!stats) {
-          const error = createError(AsarError.NOT_FOUND, { asarPath, filePath: childPath });
-          nextTick(callback!, [error]);
-          return;
-        }
-        dirents.push(new fs.Dirent(file, stats.type));
+      const { dirents, missing } = getArchiveDirents(archive, filePath, files);
+      if (!dirents) {
+        const error = createError(AsarError.NOT_FOUND, { asarPath, filePath: missing });
+        nextTick(callback!, [error]);
+        return;
       }
       nextTick(callback!, [null, dirents]);
       return;
@@ -936,14 +1010,9 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
     }
 
     if (options?.withFileTypes) {
-      const dirents = [];
-      for (const file of files) {
-        const childPath = path.join(filePath, file);
-        const stats = archive.stat(childPath);
-        if (!stats) {
-          throw createError(AsarError.NOT_FOUND, { asarPath, filePath: childPath });
-        }
-        dirents.push(new fs.Dirent(file, stats.type));
+      const { dirents, missing } = getArchiveDirents(archive, filePath, files);
+      if (!dirents) {
+        throw createError(AsarError.NOT_FOUND, { asarPath, filePath: missing });
       }
       return Promise.resolve(dirents);
     }
@@ -979,14 +1048,9 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
     }
 
     if (options?.withFileTypes) {
-      const dirents = [];
-      for (const file of files) {
-        const childPath = path.join(filePath, file);
-        const stats = archive.stat(childPath);
-        if (!stats) {
-          throw createError(AsarError.NOT_FOUND, { asarPath, filePath: childPath });
-        }
-        dirents.push(new fs.Dirent(file, stats.type));
+      const { dirents, missing } = getArchiveDirents(archive, filePath, files);
+      if (!dirents) {
+        throw createError(AsarError.NOT_FOUND, { asarPath, filePath: missing });
       }
       return dirents;
     }
@@ -1020,10 +1084,10 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
     if (!archive) return -34;
 
     // -ENOENT
-    const stats = archive.stat(filePath);
-    if (!stats) return -34;
+    const type = getCachedEntryType(archive, filePath);
+    if (type === undefined) return -34;
 
-    return (stats.type === AsarFileType.kDirectory) ? 1 : 0;
+    return (type === AsarFileType.kDirectory) ? 1 : 0;
   };
 
   const { kUsePromises } = binding;
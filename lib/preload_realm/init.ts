@@ -8,7 +8,7 @@ import * as events from 'events';
 declare const binding: {
   get: (name: string) => any;
   process: NodeJS.Process;
-  createPreloadScript: (src: string) => Function
+  createPreloadScript: (src: string, cachedData?: Uint8Array, produceCachedData?: boolean) => { result: Function, cachedData?: Uint8Array, cacheRejected?: boolean }
 };
 
 const ipcRendererUtils = require('@electron/internal/renderer/ipc-renderer-internal-utils') as typeof ipcRendererUtilsModule;
@@ -5,17 +5,21 @@ const checkContextIsolationEnabled = () => {
 };
 
 const contextBridge: Electron.ContextBridge = {
-  exposeInMainWorld: (key, api) => {
+  exposeInMainWorld: (key, api, options) => {
     checkContextIsolationEnabled();
-    return binding.exposeAPIInWorld(0, key, api);
+    return binding.exposeAPIInWorld(0, key, api, options?.lazy === true);
   },
-  exposeInIsolatedWorld: (worldId, key, api) => {
+  exposeInIsolatedWorld: (worldId, key, api, options) => {
     checkContextIsolationEnabled();
-    return binding.exposeAPIInWorld(worldId, key, api);
+    return binding.exposeAPIInWorld(worldId, key, api, options?.lazy === true);
   },
   executeInMainWorld: (script) => {
     checkContextIsolationEnabled();
     return binding.executeInWorld(0, script);
+  },
+  transfer: (buffer) => {
+    checkContextIsolationEnabled();
+    return binding.transfer(buffer);
   }
 };
 
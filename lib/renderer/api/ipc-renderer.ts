@@ -10,6 +10,10 @@ class IpcRenderer extends EventEmitter implements Electron.IpcRenderer {
     return ipc.send(internal, channel, args);
   }
 
+  sendBatched (channel: string, ...args: any[]) {
+    return ipc.sendBatched(channel, args);
+  }
+
   sendSync (channel: string, ...args: any[]) {
     return ipc.sendSync(internal, channel, args);
   }
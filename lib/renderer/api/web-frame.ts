@@ -14,7 +14,7 @@ Object.defineProperty(WebFramePrototype, 'routingId', {
   configurable: true,
   get: function (this: Electron.WebFrame) {
     routingIdDeprecated();
-    return ipcRendererUtils.invokeSync<number>(
+    return ipcRendererUtils.invokeSyncCached<number>(
       IPC_MESSAGES.BROWSER_GET_FRAME_ROUTING_ID_SYNC,
       this.frameToken
     );
@@ -26,7 +26,7 @@ WebFramePrototype.findFrameByRoutingId = function (
   routingId: number
 ): Electron.WebFrame | null {
   findFrameByRoutingIdDeprecated();
-  const frameToken = ipcRendererUtils.invokeSync<string | undefined>(
+  const frameToken = ipcRendererUtils.invokeSyncCached<string | undefined>(
     IPC_MESSAGES.BROWSER_GET_FRAME_TOKEN_SYNC,
     routingId
   );
@@ -133,7 +133,11 @@ if (nodeIntegration) {
 const { appCodeLoaded } = process;
 delete process.appCodeLoaded;
 
-const { preloadPaths } = ipcRendererUtils.invokeSync<{ preloadPaths: string[] }>(IPC_MESSAGES.BROWSER_NONSANDBOX_LOAD);
+const { preloadPaths, syncCache } = ipcRendererUtils.invokeSync<{
+  preloadPaths: string[];
+  syncCache: ElectronInternal.SyncCacheEntry[];
+}>(IPC_MESSAGES.BROWSER_NONSANDBOX_LOAD);
+ipcRendererUtils.addToSyncCache(syncCache);
 const cjsPreloads = preloadPaths.filter(p => path.extname(p) !== '.mjs');
 const esmPreloads = preloadPaths.filter(p => path.extname(p) === '.mjs');
 if (cjsPreloads.length) {
@@ -1,3 +1,4 @@
+import { SharedRingBuffer } from '@electron/internal/common/shared-ring-buffer';
 import { ipcRendererInternal } from '@electron/internal/renderer/ipc-renderer-internal';
 
 import { ipcRenderer } from 'electron/renderer';
@@ -10,5 +11,8 @@ v8Util.setHiddenValue(globalThis, 'ipcNative', {
   onMessage (internal: boolean, channel: string, ports: MessagePort[], args: any[]) {
     const sender = internal ? ipcRendererInternal : ipcRenderer;
     sender.emit(channel, { sender, ports }, ...args);
+  },
+  onSharedRingBuffer (channel: string, ring: any) {
+    ipcRenderer.emit(channel, { sender: ipcRenderer, ports: [] }, new SharedRingBuffer(ring));
   }
 });
@@ -1,3 +1,4 @@
+import { IPC_MESSAGES } from '@electron/internal/common/ipc-messages';
 import { ipcRendererInternal } from '@electron/internal/renderer/ipc-renderer-internal';
 
 type IPCHandler = (event: Electron.IpcRendererEvent, ...args: any[]) => any
@@ -22,3 +23,41 @@ export function invokeSync<T> (command: string, ...args: any[]): T {
     return result;
   }
 }
+
+// Results of sync calls that can't change for the lifetime of this context,
+// keyed by channel and then by arguments. The main process fills it ahead of
+// time so that these calls don't block on a round-trip.
+const syncCache = new Map<string, Map<string, any>>();
+
+const getSyncCacheKey = (args: any[]) => JSON.stringify(args);
+
+export function addToSyncCache (entries: ElectronInternal.SyncCacheEntry[]) {
+  for (const [command, args, result] of entries) {
+    let results = syncCache.get(command);
+    if (!results) {
+      results = new Map();
+      syncCache.set(command, results);
+    }
+    results.set(getSyncCacheKey(args), result);
+  }
+}
+
+ipcRendererInternal.on(IPC_MESSAGES.RENDERER_SYNC_CACHE_UPDATE, (event, entries: ElectronInternal.SyncCacheEntry[]) => {
+  addToSyncCache(entries);
+});
+
+// Like invokeSync, but for calls whose result never changes: they are
+// answered from the cache when possible, and cached otherwise.
+export function invokeSyncCached<T> (command: string, ...args: any[]): T {
+  const key = getSyncCacheKey(args);
+  const results = syncCache.get(command);
+  if (results?.has(key)) {
+    return results.get(key);
+  }
+
+  const result = invokeSync<T>(command, ...args);
+  if (result !== undefined) {
+    addToSyncCache([[command, args, result]]);
+  }
+  return result;
+}
@@ -8,18 +8,21 @@ import { setImmediate, clearImmediate } from 'timers';
 
 declare const binding: {
   process: NodeJS.Process;
-  createPreloadScript: (src: string) => Function
+  createPreloadScript: (src: string, cachedData?: Uint8Array, produceCachedData?: boolean) => { result: Function, cachedData?: Uint8Array, cacheRejected?: boolean }
 };
 
 const ipcRendererUtils = require('@electron/internal/renderer/ipc-renderer-internal-utils') as typeof ipcRendererUtilsModule;
 
 const {
   preloadScripts,
-  process: processProps
+  process: processProps,
+  syncCache
 } = ipcRendererUtils.invokeSync<{
   preloadScripts: ElectronInternal.PreloadScript[];
   process: NodeJS.Process;
+  syncCache: ElectronInternal.SyncCacheEntry[];
 }>(IPC_MESSAGES.BROWSER_SANDBOX_LOAD);
+ipcRendererUtils.addToSyncCache(syncCache);
 
 const electron = require('electron');
 
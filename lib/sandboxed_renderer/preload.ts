@@ -10,7 +10,7 @@ interface PreloadContext {
   /** Process object to pass into preloads. */
   process: NodeJS.Process;
 
-  createPreloadScript: (src: string) => Function
+  createPreloadScript: (src: string, cachedData?: Uint8Array, produceCachedData?: boolean) => { result: Function, cachedData?: Uint8Array, cacheRejected?: boolean }
 
   /** Globals to be exposed to preload context. */
   exposeGlobals: any;
@@ -63,7 +63,7 @@ function preloadRequire (context: PreloadContext, module: string) {
 // - `process`: The `preloadProcess` object
 // - `Buffer`: Shim of `Buffer` implementation
 // - `global`: The window object, which is aliased to `global` by webpack.
-function runPreloadScript (context: PreloadContext, preloadSrc: string) {
+function runPreloadScript (context: PreloadContext, script: ElectronInternal.PreloadScript) {
   const globalVariables = [];
   const fnParameters = [];
   for (const [key, value] of Object.entries(context.exposeGlobals)) {
@@ -71,11 +71,17 @@ function runPreloadScript (context: PreloadContext, preloadSrc: string) {
     fnParameters.push(value);
   }
   const preloadWrapperSrc = `(function(require, process, exports, module, ${globalVariables.join(', ')}) {
-  ${preloadSrc}
+  ${script.contents}
   })`;
 
-  // eval in window scope
-  const preloadFn = context.createPreloadScript(preloadWrapperSrc);
+  // eval in window scope, reusing the code cache from an earlier renderer if
+  // the browser has one
+  const produceCachedData = script.sourceHash !== undefined;
+  const { result: preloadFn, cachedData, cacheRejected } = context.createPreloadScript(preloadWrapperSrc, script.cachedData, produceCachedData);
+  if (script.cachedData || cachedData) {
+    const consumed = !!script.cachedData && !cacheRejected;
+    ipcRendererInternal.send(IPC_MESSAGES.BROWSER_PRELOAD_CODE_CACHE, script.filePath, script.sourceHash, consumed, cachedData);
+  }
   const exports = {};
 
   preloadFn(preloadRequire.bind(null, context), context.process, exports, { exports }, ...fnParameters);
@@ -85,10 +91,11 @@ function runPreloadScript (context: PreloadContext, preloadSrc: string) {
  * Execute preload scripts within a sandboxed process.
  */
 export function executeSandboxedPreloadScripts (context: PreloadContext, preloadScripts: ElectronInternal.PreloadScript[]) {
-  for (const { filePath, contents, error } of preloadScripts) {
+  for (const script of preloadScripts) {
+    const { filePath, contents, error } = script;
     try {
       if (contents) {
-        runPreloadScript(context, contents);
+        runPreloadScript(context, script);
       } else if (error) {
         throw error;
       }
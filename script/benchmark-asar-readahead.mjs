@@ -0,0 +1,118 @@
+// Measures cold-cache reads from an ASAR archive with and without a startup
+// trace recorded through ELECTRON_RECORD_ASAR_TRACE.
+//
+// Evicting the archive from the page cache needs GNU dd on Linux and `purge`
+// (usually run as root) on macOS.
+
+import { createPackage } from '@electron/asar';
+
+import * as cp from 'node:child_process';
+import * as crypto from 'node:crypto';
+import * as fs from 'node:fs';
+import * as os from 'node:os';
+import * as path from 'node:path';
+import { parseArgs } from 'node:util';
+
+import utils from './lib/utils.js';
+
+const { values: options } = parseArgs({
+  options: {
+    files: { type: 'string', default: '2000' },
+    iterations: { type: 'string', default: '5' },
+    electron: { type: 'string' }
+  }
+});
+
+function dropArchiveFromCache (archive) {
+  if (process.platform === 'linux') {
+    cp.execFileSync('dd', [`of=${archive}`, 'oflag=nocache', 'conv=notrunc,fdatasync', 'count=0'], { stdio: 'ignore' });
+  } else if (process.platform === 'darwin') {
+    cp.execFileSync('purge', { stdio: 'ignore' });
+  } else {
+    throw new Error(`Evicting the page cache is not supported on ${process.platform}`);
+  }
+}
+
+async function createArchive (dir, fileCount) {
+  const srcDir = path.join(dir, 'app');
+  const files = [];
+  for (let i = 0; i < fileCount; i++) {
+    const name = path.join(`dir${i % 50}`, `file${i}.js`);
+    fs.mkdirSync(path.join(srcDir, path.dirname(name)), { recursive: true });
+    // Sizes between 4 and 64 KiB, like a typical bundled dependency tree.
+    fs.writeFileSync(path.join(srcDir, name), crypto.randomBytes(4096 * (1 + (i * 7919) % 16)));
+    files.push(name);
+  }
+
+  const archive = path.join(dir, 'app.asar');
+  await createPackage(srcDir, archive);
+
+  // Read the files in a scattered order so that they are not sequential in
+  // the archive, the same way module loading jumps around at startup.
+  const order = files.map((name, i) => [(i * 2654435761) % 4294967296, name])
+    .sort((a, b) => a[0] - b[0])
+    .map(([, name]) => path.join(archive, name));
+  fs.writeFileSync(path.join(dir, 'order.json'), JSON.stringify(order));
+  fs.writeFileSync(path.join(dir, 'read.js'), `
+    const fs = require('node:fs');
+    for (const file of JSON.parse(fs.readFileSync(process.argv[2], 'utf8'))) {
+      fs.readFileSync(file);
+    }
+  `);
+  return archive;
+}
+
+function run (electron, dir, env = {}) {
+  const start = process.hrtime.bigint();
+  const { status } = cp.spawnSync(electron, [path.join(dir, 'read.js'), path.join(dir, 'order.json')], {
+    env: { ...process.env, ELECTRON_RUN_AS_NODE: '1', ...env },
+    stdio: 'inherit'
+  });
+  if (status !== 0) {
+    throw new Error(`Electron exited with status ${status}`);
+  }
+  return Number(process.hrtime.bigint() - start) / 1e6;
+}
+
+function median (values) {
+  const sorted = [...values].sort((a, b) => a - b);
+  return sorted[Math.floor(sorted.length / 2)];
+}
+
+async function main () {
+  const electron = options.electron || utils.getAbsoluteElectronExec();
+  const iterations = parseInt(options.iterations, 10);
+  const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-asar-readahead-'));
+
+  try {
+    const archive = await createArchive(dir, parseInt(options.files, 10));
+    run(electron, dir, { ELECTRON_RECORD_ASAR_TRACE: '600' });
+    // The recording is named after the recording process's pid; any name
+    // matching app.asar.browser.*.trace is replayed.
+    const recorded = fs.readdirSync(dir).find(name => /^app\.asar\.browser\.\d+\.trace$/.test(name));
+    const trace = `${archive}.browser.0.trace`;
+    fs.renameSync(path.join(dir, recorded), `${trace}.saved`);
+
+    const results = { 'without trace': [], 'with trace': [] };
+    for (let i = 0; i < iterations; i++) {
+      fs.rmSync(trace, { force: true });
+      dropArchiveFromCache(archive);
+      results['without trace'].push(run(electron, dir));
+
+      fs.copyFileSync(`${trace}.saved`, trace);
+      dropArchiveFromCache(archive);
+      results['with trace'].push(run(electron, dir));
+    }
+
+    for (const [name, times] of Object.entries(results)) {
+      console.log(`${name}: median ${median(times).toFixed(1)}ms (${times.map(t => t.toFixed(1)).join(', ')})`);
+    }
+  } finally {
+    fs.rmSync(dir, { recursive: true, force: true });
+  }
+}
+
+main().catch((err) => {
+  console.error(err);
+  process.exit(1);
+});
@@ -55,9 +55,11 @@
 #include "shell/browser/api/electron_api_utility_process.h"
 #include "shell/browser/api/electron_api_web_contents.h"
 #include "shell/browser/api/gpuinfo_manager.h"
+#include "shell/browser/api/ipc_metrics.h"
 #include "shell/browser/api/process_metric.h"
 #include "shell/browser/browser_process_impl.h"
 #include "shell/browser/electron_browser_main_parts.h"
+#include "shell/browser/frame_buffer_pool.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/browser/net/resolve_proxy_helper.h"
 #include "shell/browser/relauncher.h"
@@ -1485,6 +1487,51 @@ std::vector<gin_helper::Dictionary> App::GetAppMetrics(v8::Isolate* isolate) {
   return result;
 }
 
+std::vector<gin_helper::Dictionary> App::GetIpcMetrics(v8::Isolate* isolate) {
+  const IpcMetrics* ipc_metrics = IpcMetrics::GetInstance();
+  std::vector<gin_helper::Dictionary> result;
+  result.reserve(ipc_metrics->received().size() + ipc_metrics->sent().size());
+
+  auto add_metrics = [&](const IpcMetrics::ChannelMap& channels,
+                         std::string_view direction) {
+    for (const auto& [channel, metrics] : channels) {
+      auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+      dict.Set("channel", channel);
+      dict.Set("direction", direction);
+      dict.Set("count", static_cast<double>(metrics.count));
+      dict.Set("bytes", static_cast<double>(metrics.bytes));
+      if (direction == "received") {
+        std::vector<double> histogram(metrics.handler_time_histogram.begin(),
+                                      metrics.handler_time_histogram.end());
+        dict.Set("handlerTime", metrics.handler_time.InMillisecondsF());
+        dict.Set("handlerTimeHistogram", histogram);
+        dict.Set("queueTime", metrics.queue_time.InMillisecondsF());
+        dict.Set("maxQueueTime", metrics.max_queue_time.InMillisecondsF());
+      }
+      result.push_back(dict);
+    }
+  };
+  add_metrics(ipc_metrics->received(), "received");
+  add_metrics(ipc_metrics->sent(), "sent");
+
+  return result;
+}
+
+void App::ResetIpcMetrics() {
+  IpcMetrics::GetInstance()->Reset();
+}
+
+gin_helper::Dictionary App::GetFrameBufferPoolMetrics(v8::Isolate* isolate) {
+  const FrameBufferPool::Metrics metrics =
+      FrameBufferPool::GetInstance()->GetMetrics();
+  auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+  dict.Set("hits", static_cast<double>(metrics.hits));
+  dict.Set("misses", static_cast<double>(metrics.misses));
+  dict.Set("freeBuffers", static_cast<double>(metrics.free_buffers));
+  dict.Set("freeBytes", static_cast<double>(metrics.free_bytes));
+  return dict;
+}
+
 v8::Local<v8::Value> App::GetGPUFeatureStatus(v8::Isolate* isolate) {
   return gin::ConvertToV8(isolate, content::GetFeatureStatus());
 }
@@ -1946,6 +1993,9 @@ gin::ObjectTemplateBuilder App::GetObjectTemplateBuilder(v8::Isolate* isolate) {
                  &App::DisableDomainBlockingFor3DAPIs)
       .SetMethod("getFileIcon", &App::GetFileIcon)
       .SetMethod("getAppMetrics", &App::GetAppMetrics)
+      .SetMethod("getIpcMetrics", &App::GetIpcMetrics)
+      .SetMethod("resetIpcMetrics", &App::ResetIpcMetrics)
+      .SetMethod("getFrameBufferPoolMetrics", &App::GetFrameBufferPoolMetrics)
       .SetMethod("getGPUFeatureStatus", &App::GetGPUFeatureStatus)
       .SetMethod("getGPUInfo", &App::GetGPUInfo)
 #if IS_MAS_BUILD()
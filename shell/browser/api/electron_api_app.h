@@ -232,6 +232,9 @@ class App final : public gin::Wrappable<App>,
                                      gin::Arguments* args);
 
   std::vector<gin_helper::Dictionary> GetAppMetrics(v8::Isolate* isolate);
+  std::vector<gin_helper::Dictionary> GetIpcMetrics(v8::Isolate* isolate);
+  void ResetIpcMetrics();
+  gin_helper::Dictionary GetFrameBufferPoolMetrics(v8::Isolate* isolate);
   v8::Local<v8::Value> GetGPUFeatureStatus(v8::Isolate* isolate);
   v8::Local<v8::Promise> GetGPUInfo(v8::Isolate* isolate,
                                     const std::string& info_type);
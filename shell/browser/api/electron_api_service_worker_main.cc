@@ -14,6 +14,7 @@
 #include "content/browser/service_worker/service_worker_version.h"  // nogncheck
 #include "gin/object_template_builder.h"
 #include "services/service_manager/public/cpp/interface_provider.h"
+#include "shell/browser/api/ipc_metrics.h"
 #include "shell/browser/api/message_port.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/javascript_environment.h"
@@ -131,7 +132,7 @@ void ServiceWorkerMain::Send(v8::Isolate* isolate,
                              const std::string& channel,
                              v8::Local<v8::Value> args) {
   blink::CloneableMessage message;
-  if (!gin::ConvertFromV8(isolate, args, &message)) {
+  if (!electron::SerializeV8ValueForIPC(isolate, args, &message)) {
     isolate->ThrowException(v8::Exception::Error(
         gin::StringToV8(isolate, "Failed to serialize arguments")));
     return;
@@ -142,6 +143,9 @@ void ServiceWorkerMain::Send(v8::Isolate* isolate,
     return;
   }
 
+  IpcMetrics::GetInstance()->RecordMessage(IpcMetrics::Direction::kSent,
+                                           channel,
+                                           message.encoded_message.size());
   renderer_api_remote->Message(internal, channel, std::move(message));
 }
 
@@ -4,6 +4,7 @@
 
 #include "shell/browser/api/electron_api_web_contents.h"
 
+#include <algorithm>
 #include <limits>
 #include <list>
 #include <memory>
@@ -851,6 +852,10 @@ WebContents::WebContents(v8::Isolate* isolate,
                              &offscreen_shared_texture_pixel_format_);
       use_offscreen_dict.Get(options::kDeviceScaleFactor,
                              &offscreen_device_scale_factor_);
+      use_offscreen_dict.Get(options::kZeroCopy, &offscreen_zero_copy_);
+      use_offscreen_dict.Get(options::kDirtyRectOnly,
+                             &offscreen_dirty_rect_only_);
+      use_offscreen_dict.Get(options::kFramePacing, &offscreen_frame_pacing_);
     }
   }
 
@@ -889,7 +894,8 @@ WebContents::WebContents(v8::Isolate* isolate,
       auto* view = new OffScreenWebContentsView(
           false, offscreen_use_shared_texture_,
           offscreen_shared_texture_pixel_format_,
-          offscreen_device_scale_factor_,
+          offscreen_device_scale_factor_, offscreen_zero_copy_,
+          offscreen_dirty_rect_only_, offscreen_frame_pacing_,
           base::BindRepeating(&WebContents::OnPaint, base::Unretained(this)));
       params.view = view;
       params.delegate_view = view;
@@ -912,6 +918,8 @@ WebContents::WebContents(v8::Isolate* isolate,
     auto* view = new OffScreenWebContentsView(
         transparent, offscreen_use_shared_texture_,
         offscreen_shared_texture_pixel_format_, offscreen_device_scale_factor_,
+        offscreen_zero_copy_, offscreen_dirty_rect_only_,
+        offscreen_frame_pacing_,
         base::BindRepeating(&WebContents::OnPaint, base::Unretained(this)));
     params.view = view;
     params.delegate_view = view;
@@ -1275,7 +1283,8 @@ void WebContents::MaybeOverrideCreateParamsForNewWindow(
       auto* view = new OffScreenWebContentsView(
           false, offscreen_use_shared_texture_,
           offscreen_shared_texture_pixel_format_,
-          offscreen_device_scale_factor_,
+          offscreen_device_scale_factor_, offscreen_zero_copy_,
+          offscreen_dirty_rect_only_, offscreen_frame_pacing_,
           base::BindRepeating(&WebContents::OnPaint, base::Unretained(this)));
       create_params->view = view;
       create_params->delegate_view = view;
@@ -3539,22 +3548,68 @@ void WebContents::SendInputEvent(v8::Isolate* isolate,
 }
 
 void WebContents::BeginFrameSubscription(gin::Arguments* args) {
-  bool only_dirty = false;
-  FrameSubscriber::FrameCaptureCallback callback;
+  FrameSubscriber::Options options;
 
   if (args->Length() > 1) {
-    if (!args->GetNext(&only_dirty)) {
+    v8::Local<v8::Value> next = args->PeekNext();
+    if (!next.IsEmpty() && next->IsObject() && !next->IsFunction()) {
+      gin_helper::Dictionary dict;
+      args->GetNext(&dict);
+      dict.Get("onlyDirty", &options.only_dirty);
+
+      std::string pixel_format;
+      if (dict.Get("pixelFormat", &pixel_format)) {
+        if (pixel_format == "i420") {
+          options.pixel_format = media::PIXEL_FORMAT_I420;
+        } else if (pixel_format == "nv12") {
+          options.pixel_format = media::PIXEL_FORMAT_NV12;
+        } else if (pixel_format != "argb") {
+          gin_helper::ErrorThrower(args->isolate())
+              .ThrowError("'pixelFormat' must be 'argb', 'i420' or 'nv12'");
+          return;
+        }
+      }
+
+      if (dict.Get("frameRate", &options.frame_rate) &&
+          (options.frame_rate < 1 ||
+           options.frame_rate > FrameSubscriber::kMaxFrameRate)) {
+        gin_helper::ErrorThrower(args->isolate())
+            .ThrowError("'frameRate' must be in the [1, 240] range");
+        return;
+      }
+
+      gfx::Size size;
+      if (dict.Get("size", &size)) {
+        if (size.IsEmpty()) {
+          gin_helper::ErrorThrower(args->isolate())
+              .ThrowError("'size' must not be empty");
+          return;
+        }
+        options.size = size;
+      }
+    } else if (!args->GetNext(&options.only_dirty)) {
       args->ThrowError();
       return;
     }
   }
-  if (!args->GetNext(&callback)) {
-    args->ThrowError();
-    return;
-  }
 
-  frame_subscriber_ =
-      std::make_unique<FrameSubscriber>(web_contents(), callback, only_dirty);
+  if (options.pixel_format == media::PIXEL_FORMAT_ARGB) {
+    FrameSubscriber::FrameCaptureCallback callback;
+    if (!args->GetNext(&callback)) {
+      args->ThrowError();
+      return;
+    }
+    frame_subscriber_ =
+        std::make_unique<FrameSubscriber>(web_contents(), options, callback);
+  } else {
+    FrameSubscriber::PlanarFrameCaptureCallback callback;
+    if (!args->GetNext(&callback)) {
+      args->ThrowError();
+      return;
+    }
+    frame_subscriber_ =
+        std::make_unique<FrameSubscriber>(web_contents(), options, callback);
+  }
 }
 
 void WebContents::EndFrameSubscription() {
@@ -3686,7 +3741,8 @@ bool WebContents::IsOffScreen() const {
 
 void WebContents::OnPaint(const gfx::Rect& dirty_rect,
                           const SkBitmap& bitmap,
-                          const OffscreenSharedTexture& tex) {
+                          const OffscreenSharedTexture& tex,
+                          const OffscreenFrameInfo& frame_info) {
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
 
@@ -3700,8 +3756,72 @@ void WebContents::OnPaint(const gfx::Rect& dirty_rect,
     dict.Set("texture", tex);
   }
 
+  // Times are in milliseconds since the epoch, like Date.now().
+  auto to_epoch_ms = [](base::TimeTicks ticks) {
+    return (ticks - base::TimeTicks::UnixEpoch()).InMillisecondsF();
+  };
+  auto timing = gin_helper::Dictionary::CreateEmpty(isolate);
+  timing.Set("beginFrameTime", to_epoch_ms(frame_info.begin_frame_time));
+  timing.Set("captureTime", to_epoch_ms(frame_info.capture_time));
+  timing.Set("deliveryTime", to_epoch_ms(base::TimeTicks::Now()));
+  dict.Set("timing", timing);
+  dict.Set("droppedFrames", frame_info.dropped_frames);
+
+  const uint64_t paint_id = ++paint_id_;
+  paint_deferred_ = false;
+  paint_acknowledged_ = false;
+  paint_begin_frame_time_ = frame_info.begin_frame_time;
+  ++paint_count_;
+  dropped_paint_count_ += frame_info.dropped_frames;
+  if (offscreen_frame_pacing_) {
+    dict.Set("defer",
+             base::BindRepeating(&WebContents::DeferPaintAcknowledgement,
+                                 GetWeakPtr(), paint_id));
+  }
+
   EmitWithoutEvent("paint", event_object, dirty_rect,
                    gfx::Image::CreateFrom1xBitmap(bitmap));
+
+  if (paint_deferred_)
+    return;
+  if (offscreen_frame_pacing_) {
+    // Acknowledging from a task lets the frames that were captured while the
+    // listeners ran be merged into one.
+    AcknowledgePaintSoon(paint_id);
+  } else {
+    AcknowledgePaint(paint_id);
+  }
+}
+
+base::OnceClosure WebContents::DeferPaintAcknowledgement(uint64_t paint_id) {
+  if (paint_id == paint_id_ && !paint_acknowledged_)
+    paint_deferred_ = true;
+  return base::BindOnce(&WebContents::AcknowledgePaintSoon, GetWeakPtr(),
+                        paint_id);
+}
+
+void WebContents::AcknowledgePaintSoon(uint64_t paint_id) {
+  // Never delivers the next frame from within a paint listener.
+  content::GetUIThreadTaskRunner({})->PostTask(
+      FROM_HERE,
+      base::BindOnce(&WebContents::AcknowledgePaint, GetWeakPtr(), paint_id));
+}
+
+void WebContents::AcknowledgePaint(uint64_t paint_id) {
+  // Only the last paint event can be in flight.
+  if (paint_id != paint_id_ || paint_acknowledged_)
+    return;
+  paint_acknowledged_ = true;
+
+  const base::TimeDelta latency =
+      base::TimeTicks::Now() - paint_begin_frame_time_;
+  total_paint_latency_ += latency;
+  max_paint_latency_ = std::max(max_paint_latency_, latency);
+
+  if (offscreen_frame_pacing_) {
+    if (auto* osr_rwhv = GetOffScreenRenderWidgetHostView())
+      osr_rwhv->AcknowledgeFrame();
+  }
 }
 
 void WebContents::StartPainting() {
@@ -3744,6 +3864,17 @@ void WebContents::Invalidate() {
   }
 }
 
+v8::Local<v8::Value> WebContents::GetPaintMetrics(v8::Isolate* isolate) const {
+  auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+  dict.Set("paintCount", static_cast<double>(paint_count_));
+  dict.Set("droppedFrames", static_cast<double>(dropped_paint_count_));
+  dict.Set("averageLatency",
+           paint_count_ ? total_paint_latency_.InMillisecondsF() / paint_count_
+                        : 0.0);
+  dict.Set("maxLatency", max_paint_latency_.InMillisecondsF());
+  return dict.GetHandle();
+}
+
 gfx::Size WebContents::GetSizeForNewRenderView(content::WebContents* wc) {
   if (IsOffScreen() && wc == web_contents()) {
     auto* relay = NativeWindowRelay::FromWebContents(web_contents());
@@ -4557,6 +4688,7 @@ void WebContents::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("setFrameRate", &WebContents::SetFrameRate)
       .SetMethod("getFrameRate", &WebContents::GetFrameRate)
       .SetMethod("invalidate", &WebContents::Invalidate)
+      .SetMethod("getPaintMetrics", &WebContents::GetPaintMetrics)
       .SetMethod("setZoomLevel", &WebContents::SetZoomLevel)
       .SetMethod("getZoomLevel", &WebContents::GetZoomLevel)
       .SetMethod("setZoomFactor", &WebContents::SetZoomFactor)
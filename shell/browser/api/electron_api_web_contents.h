@@ -319,13 +319,15 @@ class WebContents final : public ExclusiveAccessContext,
   bool IsOffScreen() const;
   void OnPaint(const gfx::Rect& dirty_rect,
                const SkBitmap& bitmap,
-               const OffscreenSharedTexture& info);
+               const OffscreenSharedTexture& info,
+               const OffscreenFrameInfo& frame_info);
   void StartPainting();
   void StopPainting();
   bool IsPainting() const;
   void SetFrameRate(int frame_rate);
   int GetFrameRate() const;
   void Invalidate();
+  v8::Local<v8::Value> GetPaintMetrics(v8::Isolate* isolate) const;
   gfx::Size GetSizeForNewRenderView(content::WebContents*) override;
 
   // Methods for zoom handling.
@@ -474,6 +476,12 @@ class WebContents final : public ExclusiveAccessContext,
   // Delete this if garbage collection has not started.
   void DeleteThisIfAlive();
 
+  // Frame pacing of offscreen rendering: keeps the paint event |paint_id| in
+  // flight until the returned closure runs.
+  base::OnceClosure DeferPaintAcknowledgement(uint64_t paint_id);
+  void AcknowledgePaintSoon(uint64_t paint_id);
+  void AcknowledgePaint(uint64_t paint_id);
+
   // Creates a InspectableWebContents object and takes ownership of
   // |web_contents|.
   void InitWithWebContents(std::unique_ptr<content::WebContents> web_contents,
@@ -827,6 +835,27 @@ class WebContents final : public ExclusiveAccessContext,
   // `deviceScaleFactor` is not specified in webPreferences.
   float offscreen_device_scale_factor_ = 0.0f;
 
+  // Whether offscreen rendering paints the captured frames without copying
+  bool offscreen_zero_copy_ = false;
+
+  // Whether offscreen rendering paints only the dirty area of the frames
+  bool offscreen_dirty_rect_only_ = false;
+
+  // Whether offscreen rendering waits for paint events to be acknowledged
+  bool offscreen_frame_pacing_ = false;
+
+  // The last paint event, and whether it's still waiting to be acknowledged
+  uint64_t paint_id_ = 0U;
+  bool paint_deferred_ = false;
+  bool paint_acknowledged_ = true;
+  base::TimeTicks paint_begin_frame_time_;
+
+  // Counters of the paint events
+  uint64_t paint_count_ = 0U;
+  uint64_t dropped_paint_count_ = 0U;
+  base::TimeDelta total_paint_latency_;
+  base::TimeDelta max_paint_latency_;
+
   // Whether window is fullscreened by HTML5 api.
   bool html_fullscreen_ = false;
 
@@ -4,6 +4,7 @@
 
 #include "shell/browser/api/electron_api_web_frame_main.h"
 
+#include <bit>
 #include <string>
 #include <utility>
 #include <vector>
@@ -19,10 +20,12 @@
 #include "content/public/common/isolated_world_ids.h"
 #include "gin/object_template_builder.h"
 #include "services/service_manager/public/cpp/interface_provider.h"
+#include "shell/browser/api/ipc_metrics.h"
 #include "shell/browser/api/message_port.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/common/api/api.mojom.h"
+#include "shell/common/api/electron_api_shared_ring_buffer.h"
 #include "shell/common/gin_converters/blink_converter.h"
 #include "shell/common/gin_converters/frame_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
@@ -275,7 +278,7 @@ void WebFrameMain::Send(v8::Isolate* isolate,
                         const std::string& channel,
                         v8::Local<v8::Value> args) {
   blink::CloneableMessage message;
-  if (!gin::ConvertFromV8(isolate, args, &message)) {
+  if (!electron::SerializeV8ValueForIPC(isolate, args, &message)) {
     isolate->ThrowException(v8::Exception::Error(
         gin::StringToV8(isolate, "Failed to serialize arguments")));
     return;
@@ -284,6 +287,9 @@ void WebFrameMain::Send(v8::Isolate* isolate,
   if (!CheckRenderFrame())
     return;
 
+  IpcMetrics::GetInstance()->RecordMessage(IpcMetrics::Direction::kSent,
+                                           channel,
+                                           message.encoded_message.size());
   GetRendererApi()->Message(internal, channel, std::move(message));
 }
 
@@ -365,10 +371,45 @@ void WebFrameMain::PostMessage(v8::Isolate* isolate,
   if (!CheckRenderFrame())
     return;
 
+  IpcMetrics::GetInstance()->RecordMessage(
+      IpcMetrics::Direction::kSent, channel,
+      transferable_message.encoded_message.size());
   GetRendererApi()->ReceivePostMessage(channel,
                                        std::move(transferable_message));
 }
 
+v8::Local<v8::Value> WebFrameMain::CreateSharedRingBuffer(
+    v8::Isolate* isolate,
+    const std::string& channel,
+    uint32_t capacity) {
+  gin_helper::ErrorThrower thrower(isolate);
+  if (capacity < SharedRingBuffer::kMinCapacity ||
+      capacity > SharedRingBuffer::kMaxCapacity) {
+    thrower.ThrowRangeError("capacity must be between 4 KiB and 64 MiB");
+    return v8::Null(isolate);
+  }
+
+  if (!CheckRenderFrame())
+    return v8::Null(isolate);
+
+  auto endpoints = SharedRingBuffer::CreateEndpoints(
+      std::bit_ceil(static_cast<size_t>(capacity)));
+  if (!endpoints) {
+    thrower.ThrowError("Failed to allocate shared memory");
+    return v8::Null(isolate);
+  }
+
+  auto ring = SharedRingBuffer::Create(isolate, std::move(endpoints->first));
+  if (ring.IsEmpty()) {
+    thrower.ThrowError("Failed to create SharedRingBuffer");
+    return v8::Null(isolate);
+  }
+
+  GetRendererApi()->ReceiveSharedRingBuffer(channel,
+                                            std::move(endpoints->second));
+  return ring.ToV8();
+}
+
 bool WebFrameMain::Detached() const {
   return render_frame_detached_;
 }
@@ -597,6 +638,8 @@ void WebFrameMain::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("isDestroyed", &WebFrameMain::IsDestroyed)
       .SetMethod("_send", &WebFrameMain::Send)
       .SetMethod("_postMessage", &WebFrameMain::PostMessage)
+      .SetMethod("_createSharedRingBuffer",
+                 &WebFrameMain::CreateSharedRingBuffer)
       .SetProperty("detached", &WebFrameMain::Detached)
       .SetProperty("frameTreeNodeId", &WebFrameMain::FrameTreeNodeID)
       .SetProperty("name", &WebFrameMain::Name)
@@ -128,6 +128,9 @@ class WebFrameMain final : public gin_helper::DeprecatedWrappable<WebFrameMain>,
                    const std::string& channel,
                    v8::Local<v8::Value> message_value,
                    std::optional<v8::Local<v8::Value>> transfer);
+  v8::Local<v8::Value> CreateSharedRingBuffer(v8::Isolate* isolate,
+                                              const std::string& channel,
+                                              uint32_t capacity);
 
   bool Detached() const;
   content::FrameTreeNodeId FrameTreeNodeID() const;
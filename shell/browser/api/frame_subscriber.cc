@@ -5,30 +5,49 @@
 #include "shell/browser/api/frame_subscriber.h"
 
 #include <utility>
+#include <vector>
 
+#include "base/numerics/safe_conversions.h"
 #include "content/public/browser/page.h"
 #include "content/public/browser/render_view_host.h"
 #include "content/public/browser/render_widget_host.h"
 #include "content/public/browser/render_widget_host_view.h"
 #include "content/public/browser/web_contents.h"
+#include "media/base/video_frame.h"
 #include "media/capture/mojom/video_capture_buffer.mojom.h"
 #include "media/capture/mojom/video_capture_types.mojom.h"
 #include "mojo/public/cpp/bindings/remote.h"
 #include "services/viz/privileged/mojom/compositing/frame_sink_video_capture.mojom-shared.h"
+#include "shell/browser/frame_buffer_pool.h"
+#include "shell/common/gin_converters/gfx_converter.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/node_includes.h"
+#include "shell/common/node_util.h"
+#include "third_party/libyuv/include/libyuv/planar_functions.h"
 #include "ui/gfx/geometry/size_conversions.h"
 #include "ui/gfx/image/image.h"
 #include "ui/gfx/skbitmap_operations.h"
 
 namespace electron::api {
 
-constexpr static int kMaxFrameRate = 30;
+FrameSubscriber::FrameSubscriber(content::WebContents* web_contents,
+                                 const Options& options,
+                                 const FrameCaptureCallback& callback)
+    : content::WebContentsObserver(web_contents),
+      options_(options),
+      callback_(callback) {
+  DCHECK_EQ(options_.pixel_format, media::PIXEL_FORMAT_ARGB);
+  AttachToHost(web_contents->GetPrimaryMainFrame()->GetRenderWidgetHost());
+}
 
 FrameSubscriber::FrameSubscriber(content::WebContents* web_contents,
-                                 const FrameCaptureCallback& callback,
-                                 bool only_dirty)
+                                 const Options& options,
+                                 const PlanarFrameCaptureCallback& callback)
     : content::WebContentsObserver(web_contents),
-      callback_(callback),
-      only_dirty_(only_dirty) {
+      options_(options),
+      planar_callback_(callback) {
+  DCHECK(options_.pixel_format == media::PIXEL_FORMAT_I420 ||
+         options_.pixel_format == media::PIXEL_FORMAT_NV12);
   AttachToHost(web_contents->GetPrimaryMainFrame()->GetRenderWidgetHost());
 }
 
@@ -43,15 +62,19 @@ void FrameSubscriber::AttachToHost(content::RenderWidgetHost* host) {
   if (!rwhv)
     return;
 
-  // Create and configure the video capturer.
-  gfx::Size size = GetRenderViewSize();
-  DCHECK(!size.IsEmpty());
+  // Create and configure the video capturer. NV12 frames are captured as
+  // I420, since the capturer only produces NV12 in GPU memory buffers.
+  requested_size_ = GetCaptureSize();
+  DCHECK(!requested_size_.IsEmpty());
   video_capturer_ = rwhv->CreateVideoCapturer();
-  video_capturer_->SetResolutionConstraints(size, size, true);
+  video_capturer_->SetResolutionConstraints(requested_size_, requested_size_,
+                                            true);
   video_capturer_->SetAutoThrottlingEnabled(false);
   video_capturer_->SetMinSizeChangePeriod(base::TimeDelta());
-  video_capturer_->SetFormat(media::PIXEL_FORMAT_ARGB);
-  video_capturer_->SetMinCapturePeriod(base::Seconds(1) / kMaxFrameRate);
+  video_capturer_->SetFormat(options_.pixel_format == media::PIXEL_FORMAT_ARGB
+                                 ? media::PIXEL_FORMAT_ARGB
+                                 : media::PIXEL_FORMAT_I420);
+  video_capturer_->SetMinCapturePeriod(base::Seconds(1) / options_.frame_rate);
   video_capturer_->Start(this, viz::mojom::BufferFormatPreference::kDefault);
 }
 
@@ -90,12 +113,21 @@ void FrameSubscriber::OnFrameCaptured(
         callbacks) {
   auto& data_region = data->get_read_only_shmem_region();
 
-  gfx::Size size = GetRenderViewSize();
-  if (size != content_rect.size()) {
+  gfx::Size size = GetCaptureSize();
+  if (size != requested_size_) {
+    requested_size_ = size;
     video_capturer_->SetResolutionConstraints(size, size, true);
     video_capturer_->RequestRefreshFrame();
     return;
   }
+  // Drop the ARGB frames captured before a resize took effect. Frames of a
+  // fixed size, and planar frames whose dimensions are rounded to even
+  // numbers, are letterboxed instead of matching the requested size.
+  if (!options_.size && options_.pixel_format == media::PIXEL_FORMAT_ARGB &&
+      size != content_rect.size()) {
+    video_capturer_->RequestRefreshFrame();
+    return;
+  }
 
   mojo::Remote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
       callbacks_remote(std::move(callbacks));
@@ -114,6 +146,32 @@ void FrameSubscriber::OnFrameCaptured(
     return;
   }
 
+  if (info->pixel_format == media::PIXEL_FORMAT_I420) {
+    // The planes are laid out one after the other, each with the minimum
+    // stride for the frame's coded width.
+    PlanarVideoFrame frame{.pixel_format = options_.pixel_format,
+                           .coded_size = info->coded_size,
+                           .content_rect = content_rect,
+                           .timestamp = info->timestamp};
+    base::span<const uint8_t> memory = mapping.GetMemoryAsSpan<uint8_t>();
+    size_t offset = 0U;
+    for (size_t plane = 0U; plane < frame.planes.size(); ++plane) {
+      frame.strides[plane] = media::VideoFrame::RowBytes(
+          plane, info->pixel_format, info->coded_size.width());
+      const size_t plane_size =
+          frame.strides[plane] *
+          media::VideoFrame::Rows(plane, info->pixel_format,
+                                  info->coded_size.height());
+      frame.planes[plane] = memory.subspan(offset, plane_size);
+      offset += plane_size;
+    }
+
+    // |mapping| and |callbacks_remote| outlive the callback, after which the
+    // capturer may recycle the frame.
+    planar_callback_.Run(gfx::Image(), content_rect, frame);
+    return;
+  }
+
   // The SkBitmap's pixels will be marked as immutable, but the installPixels()
   // API requires a non-const pointer. So, cast away the const.
   void* const pixels = const_cast<void*>(mapping.memory());
@@ -149,17 +207,20 @@ void FrameSubscriber::Done(const gfx::Rect& damage, const SkBitmap& frame) {
   if (frame.drawsNothing())
     return;
 
-  const SkBitmap& bitmap = only_dirty_ ? SkBitmapOperations::CreateTiledBitmap(
-                                             frame, damage.x(), damage.y(),
-                                             damage.width(), damage.height())
-                                       : frame;
+  const SkBitmap& bitmap =
+      options_.only_dirty
+          ? SkBitmapOperations::CreateTiledBitmap(frame, damage.x(), damage.y(),
+                                                  damage.width(),
+                                                  damage.height())
+          : frame;
 
   // Copying SkBitmap does not copy the internal pixels, we have to manually
   // allocate and write pixels otherwise crash may happen when the original
   // frame is modified.
   SkBitmap copy;
-  copy.allocPixels(SkImageInfo::Make(bitmap.width(), bitmap.height(),
-                                     kN32_SkColorType, kPremul_SkAlphaType));
+  FrameBufferPool::GetInstance()->AllocPixels(
+      &copy, SkImageInfo::Make(bitmap.width(), bitmap.height(),
+                               kN32_SkColorType, kPremul_SkAlphaType));
   SkPixmap pixmap;
   bool success = bitmap.peekPixels(&pixmap) && copy.writePixels(pixmap, 0, 0);
   CHECK(success);
@@ -174,4 +235,61 @@ gfx::Size FrameSubscriber::GetRenderViewSize() const {
       gfx::ScaleSize(gfx::SizeF(size), view->GetDeviceScaleFactor()));
 }
 
+gfx::Size FrameSubscriber::GetCaptureSize() const {
+  return options_.size.value_or(GetRenderViewSize());
+}
+
 }  // namespace electron::api
+
+namespace gin {
+
+// static
+v8::Local<v8::Value> Converter<electron::api::PlanarVideoFrame>::ToV8(
+    v8::Isolate* isolate,
+    const electron::api::PlanarVideoFrame& frame) {
+  const bool nv12 = frame.pixel_format == media::PIXEL_FORMAT_NV12;
+
+  std::vector<v8::Local<v8::Value>> planes;
+  auto add_plane = [&](v8::Local<v8::Object> data, size_t stride) {
+    auto plane = gin_helper::Dictionary::CreateEmpty(isolate);
+    plane.Set("data", data);
+    plane.Set("stride", static_cast<double>(stride));
+    planes.push_back(plane.GetHandle());
+  };
+
+  add_plane(electron::Buffer::Copy(isolate, frame.planes[0]).ToLocalChecked(),
+            frame.strides[0]);
+  if (nv12) {
+    const int width = frame.coded_size.width();
+    const int height = frame.coded_size.height();
+    const size_t stride = media::VideoFrame::RowBytes(
+        media::VideoFrame::Plane::kUV, media::PIXEL_FORMAT_NV12, width);
+    const size_t rows = media::VideoFrame::Rows(
+        media::VideoFrame::Plane::kUV, media::PIXEL_FORMAT_NV12, height);
+    v8::Local<v8::Object> data =
+        node::Buffer::New(isolate, stride * rows).ToLocalChecked();
+    libyuv::MergeUVPlane(
+        frame.planes[1].data(), base::checked_cast<int>(frame.strides[1]),
+        frame.planes[2].data(), base::checked_cast<int>(frame.strides[2]),
+        electron::Buffer::as_byte_span(data).data(),
+        base::checked_cast<int>(stride), (width + 1) / 2,
+        base::checked_cast<int>(rows));
+    add_plane(data, stride);
+  } else {
+    for (size_t plane = 1U; plane < frame.planes.size(); ++plane) {
+      add_plane(
+          electron::Buffer::Copy(isolate, frame.planes[plane]).ToLocalChecked(),
+          frame.strides[plane]);
+    }
+  }
+
+  auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+  dict.Set("pixelFormat", nv12 ? "nv12" : "i420");
+  dict.Set("codedSize", frame.coded_size);
+  dict.Set("contentRect", frame.content_rect);
+  dict.Set("timestamp", frame.timestamp.InMillisecondsF());
+  dict.Set("planes", planes);
+  return dict.GetHandle();
+}
+
+}  // namespace gin
@@ -5,20 +5,27 @@
 #ifndef ELECTRON_SHELL_BROWSER_API_FRAME_SUBSCRIBER_H_
 #define ELECTRON_SHELL_BROWSER_API_FRAME_SUBSCRIBER_H_
 
+#include <array>
 #include <memory>
+#include <optional>
 #include <string>
 
+#include "base/containers/span.h"
 #include "base/functional/callback_forward.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "components/viz/host/client_frame_sink_video_capturer.h"
 #include "content/public/browser/web_contents_observer.h"
+#include "gin/converter.h"
+#include "media/base/video_types.h"
 #include "media/capture/mojom/video_capture_buffer.mojom-forward.h"
+#include "ui/gfx/geometry/rect.h"
+#include "ui/gfx/geometry/size.h"
 #include "v8/include/v8-forward.h"
 
 namespace gfx {
 class Image;
-class Rect;
 }  // namespace gfx
 
 namespace mojo {
@@ -30,15 +37,55 @@ namespace electron::api {
 
 class WebContents;
 
+// A frame captured in a planar YUV format. Its planes point into the
+// capturer's shared memory, which is only mapped during the callback.
+struct PlanarVideoFrame {
+  // The format requested by the subscriber, I420 or NV12. The frame is always
+  // captured as I420; the U and V planes are interleaved into NV12's UV plane
+  // when it is handed to JS.
+  media::VideoPixelFormat pixel_format;
+  gfx::Size coded_size;
+  // The area of the frame that the page was drawn into. The rest is
+  // letterboxing, if the page doesn't have the frame's aspect ratio.
+  gfx::Rect content_rect;
+  base::TimeDelta timestamp;
+  // The Y, U and V planes and their strides in bytes.
+  std::array<base::span<const uint8_t>, 3> planes = {};
+  std::array<size_t, 3> strides = {};
+};
+
 class FrameSubscriber : private content::WebContentsObserver,
                         private viz::mojom::FrameSinkVideoConsumer {
  public:
   using FrameCaptureCallback =
       base::RepeatingCallback<void(const gfx::Image&, const gfx::Rect&)>;
+  // Receives an empty image, the damage and the frame, so that JS sees the
+  // same arguments as FrameCaptureCallback's plus the planar frame.
+  using PlanarFrameCaptureCallback =
+      base::RepeatingCallback<void(const gfx::Image&,
+                                   const gfx::Rect&,
+                                   const PlanarVideoFrame&)>;
+
+  static constexpr int kDefaultFrameRate = 30;
+  static constexpr int kMaxFrameRate = 240;
+
+  struct Options {
+    // Only used for ARGB frames, planar frames always hold the whole page.
+    bool only_dirty = false;
+    // ARGB, I420 or NV12.
+    media::VideoPixelFormat pixel_format = media::PIXEL_FORMAT_ARGB;
+    int frame_rate = kDefaultFrameRate;
+    // The size of the frames in pixels. Defaults to the size of the view, which
+    // the frames follow when it is resized.
+    std::optional<gfx::Size> size;
+  };
 
   FrameSubscriber(content::WebContents* web_contents,
-                  const FrameCaptureCallback& callback,
-                  bool only_dirty);
+                  const Options& options,
+                  const FrameCaptureCallback& callback);
+  FrameSubscriber(content::WebContents* web_contents,
+                  const Options& options,
+                  const PlanarFrameCaptureCallback& callback);
   ~FrameSubscriber() override;
 
   // disable copy
@@ -72,8 +119,15 @@ class FrameSubscriber : private content::WebContentsObserver,
   // Get the pixel size of render view.
   gfx::Size GetRenderViewSize() const;
 
+  // Get the pixel size of the captured frames.
+  gfx::Size GetCaptureSize() const;
+
+  const Options options_;
   FrameCaptureCallback callback_;
-  bool only_dirty_;
+  PlanarFrameCaptureCallback planar_callback_;
+
+  // The size passed to the capturer's resolution constraints.
+  gfx::Size requested_size_;
 
   raw_ptr<content::RenderWidgetHost> host_;
   std::unique_ptr<viz::ClientFrameSinkVideoCapturer> video_capturer_;
@@ -83,4 +137,15 @@ class FrameSubscriber : private content::WebContentsObserver,
 
 }  // namespace electron::api
 
+namespace gin {
+
+template <>
+struct Converter<electron::api::PlanarVideoFrame> {
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      const electron::api::PlanarVideoFrame& frame);
+};
+
+}  // namespace gin
+
 #endif  // ELECTRON_SHELL_BROWSER_API_FRAME_SUBSCRIBER_H_
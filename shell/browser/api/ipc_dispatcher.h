@@ -6,9 +6,12 @@
 #define ELECTRON_SHELL_BROWSER_API_IPC_DISPATCHER_H_
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/trace_event/trace_event.h"
 #include "base/values.h"
+#include "shell/browser/api/ipc_metrics.h"
 #include "shell/browser/api/message_port.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/common/api/api.mojom.h"
@@ -33,13 +36,38 @@ class IpcDispatcher {
                const std::string& channel,
                blink::CloneableMessage args) {
     TRACE_EVENT1("electron", "IpcDispatcher::Message", "channel", channel);
+    IpcMetrics::ScopedDispatch dispatch(channel, args.encoded_message.size());
     emitter()->EmitWithoutEvent("-ipc-message", event, channel, args);
   }
 
+  // All messages of a batch are emitted from a single call into JS, which
+  // dispatches them in order with the same event. Their handlers aren't timed
+  // separately, so the batch's handler time isn't attributed to any channel.
+  void MessageBatch(v8::Local<v8::Object> event,
+                    std::vector<mojom::BatchedMessagePtr> messages) {
+    TRACE_EVENT1("electron", "IpcDispatcher::MessageBatch", "count",
+                 messages.size());
+    std::vector<std::string> channels;
+    std::vector<blink::CloneableMessage> arguments;
+    channels.reserve(messages.size());
+    arguments.reserve(messages.size());
+    for (auto& message : messages) {
+      IpcMetrics::GetInstance()->RecordMessage(
+          IpcMetrics::Direction::kReceived, message->channel,
+          message->arguments.encoded_message.size());
+      channels.push_back(std::move(message->channel));
+      arguments.push_back(std::move(message->arguments));
+    }
+    emitter()->EmitWithoutEvent("-ipc-message-batch", event, channels,
+                                arguments);
+  }
+
   void Invoke(v8::Local<v8::Object> event,
               const std::string& channel,
               blink::CloneableMessage arguments) {
     TRACE_EVENT1("electron", "IpcDispatcher::Invoke", "channel", channel);
+    IpcMetrics::ScopedDispatch dispatch(channel,
+                                        arguments.encoded_message.size());
     emitter()->EmitWithoutEvent("-ipc-invoke", event, channel,
                                 std::move(arguments));
   }
@@ -49,6 +77,8 @@ class IpcDispatcher {
                           blink::TransferableMessage message) {
     TRACE_EVENT1("electron", "IpcDispatcher::ReceivePostMessage", "channel",
                  channel);
+    IpcMetrics::ScopedDispatch dispatch(channel,
+                                        message.encoded_message.size());
     v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
     v8::HandleScope handle_scope(isolate);
     auto wrapped_ports =
@@ -63,6 +93,8 @@ class IpcDispatcher {
                    const std::string& channel,
                    blink::CloneableMessage arguments) {
     TRACE_EVENT1("electron", "IpcDispatcher::MessageSync", "channel", channel);
+    IpcMetrics::ScopedDispatch dispatch(channel,
+                                        arguments.encoded_message.size());
     emitter()->EmitWithoutEvent("-ipc-message-sync", event, channel,
                                 std::move(arguments));
   }
@@ -71,6 +103,8 @@ class IpcDispatcher {
                    const std::string& channel,
                    blink::CloneableMessage arguments) {
     TRACE_EVENT1("electron", "IpcDispatcher::MessageHost", "channel", channel);
+    IpcMetrics::ScopedDispatch dispatch(channel,
+                                        arguments.encoded_message.size());
     emitter()->EmitWithoutEvent("-ipc-message-host", event, channel,
                                 std::move(arguments));
   }
@@ -0,0 +1,122 @@
+// Copyright (c) 2026 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/ipc_metrics.h"
+
+#include <algorithm>
+#include <optional>
+
+#include "base/pending_task.h"
+#include "base/strings/strcat.h"
+#include "base/task/common/task_annotator.h"
+#include "base/trace_event/trace_event.h"
+#include "content/public/browser/browser_thread.h"
+
+namespace electron {
+
+namespace {
+
+std::string_view GetDirectionName(IpcMetrics::Direction direction) {
+  return direction == IpcMetrics::Direction::kReceived ? "received" : "sent";
+}
+
+// Returns how long the current task waited in its queue. For a task that
+// dispatches a Mojo message, that is the time between the message's arrival
+// on the IO thread and its dispatch. Not every queue records when its tasks
+// were posted.
+std::optional<base::TimeDelta> GetCurrentTaskQueueTime() {
+  const base::PendingTask* task = base::TaskAnnotator::CurrentTaskForThread();
+  if (!task || task->queue_time.is_null())
+    return std::nullopt;
+  return base::TimeTicks::Now() - task->queue_time;
+}
+
+void TraceCounters(IpcMetrics::Direction direction,
+                   std::string_view channel,
+                   const IpcMetrics::ChannelMetrics& metrics) {
+  bool enabled = false;
+  TRACE_EVENT_CATEGORY_GROUP_ENABLED("electron", &enabled);
+  if (!enabled)
+    return;
+
+  const std::string_view direction_name = GetDirectionName(direction);
+  TRACE_COUNTER("electron",
+                perfetto::CounterTrack(perfetto::DynamicString{base::StrCat(
+                    {"IPC messages ", direction_name, ": ", channel})}),
+                metrics.count);
+  TRACE_COUNTER("electron",
+                perfetto::CounterTrack(perfetto::DynamicString{base::StrCat(
+                    {"IPC bytes ", direction_name, ": ", channel})}),
+                metrics.bytes);
+}
+
+}  // namespace
+
+IpcMetrics::ScopedDispatch::ScopedDispatch(std::string_view channel,
+                                           size_t bytes)
+    : channel_(channel), start_time_(base::TimeTicks::Now()) {
+  GetInstance()->RecordMessage(Direction::kReceived, channel, bytes);
+}
+
+IpcMetrics::ScopedDispatch::~ScopedDispatch() {
+  // The entry is looked up again because JS may have reset the metrics.
+  GetInstance()->RecordHandlerTime(channel_,
+                                   base::TimeTicks::Now() - start_time_);
+}
+
+// static
+IpcMetrics* IpcMetrics::GetInstance() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  static base::NoDestructor<IpcMetrics> instance;
+  return instance.get();
+}
+
+IpcMetrics::IpcMetrics() = default;
+
+IpcMetrics::~IpcMetrics() = default;
+
+void IpcMetrics::RecordMessage(Direction direction,
+                               std::string_view channel,
+                               size_t bytes) {
+  ChannelMetrics& metrics = GetChannelMetrics(direction, channel);
+  ++metrics.count;
+  metrics.bytes += bytes;
+
+  if (direction == Direction::kReceived) {
+    if (auto queue_time = GetCurrentTaskQueueTime()) {
+      metrics.queue_time += *queue_time;
+      metrics.max_queue_time = std::max(metrics.max_queue_time, *queue_time);
+    }
+  }
+
+  TraceCounters(direction, channel, metrics);
+}
+
+void IpcMetrics::RecordHandlerTime(std::string_view channel,
+                                   base::TimeDelta time) {
+  ChannelMetrics& metrics = GetChannelMetrics(Direction::kReceived, channel);
+  metrics.handler_time += time;
+  const auto bucket = std::ranges::lower_bound(kHandlerTimeBounds, time) -
+                      kHandlerTimeBounds.begin();
+  ++metrics.handler_time_histogram[bucket];
+}
+
+void IpcMetrics::Reset() {
+  received_.clear();
+  sent_.clear();
+}
+
+IpcMetrics::ChannelMetrics& IpcMetrics::GetChannelMetrics(
+    Direction direction,
+    std::string_view channel) {
+  ChannelMap& channels = direction == Direction::kReceived ? received_ : sent_;
+  if (auto it = channels.find(channel); it != channels.end())
+    return it->second;
+
+  if (channels.size() >= kMaxChannels)
+    channel = kOverflowChannel;
+  return channels.try_emplace(std::string{channel}).first->second;
+}
+
+}  // namespace electron
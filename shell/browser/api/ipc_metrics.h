@@ -0,0 +1,100 @@
+// Copyright (c) 2026 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_API_IPC_METRICS_H_
+#define ELECTRON_SHELL_BROWSER_API_IPC_METRICS_H_
+
+#include <array>
+#include <string>
+#include <string_view>
+
+#include "base/no_destructor.h"
+#include "base/time/time.h"
+#include "third_party/abseil-cpp/absl/container/flat_hash_map.h"
+
+namespace electron {
+
+// Counters of the IPC messages that the main process receives from and sends
+// to renderers, kept per channel and direction. They are always collected and
+// only cost a table lookup per message, so that the channels which dominate
+// main-process time can be found without attaching a profiler.
+class IpcMetrics {
+ public:
+  enum class Direction { kReceived, kSent };
+
+  // Upper bounds of the handler time histogram buckets. The last bucket holds
+  // everything slower.
+  static constexpr std::array<base::TimeDelta, 4> kHandlerTimeBounds = {
+      base::Microseconds(100), base::Milliseconds(1), base::Milliseconds(10),
+      base::Milliseconds(100)};
+
+  // Channels past this many in a direction are counted together under
+  // kOverflowChannel, so that channel names built at runtime can't grow the
+  // table without bound.
+  static constexpr size_t kMaxChannels = 1000U;
+  static constexpr std::string_view kOverflowChannel = "<other>";
+
+  struct ChannelMetrics {
+    uint64_t count = 0U;
+    uint64_t bytes = 0U;
+    base::TimeDelta handler_time;
+    std::array<uint64_t, kHandlerTimeBounds.size() + 1> handler_time_histogram =
+        {};
+    base::TimeDelta queue_time;
+    base::TimeDelta max_queue_time;
+  };
+
+  using ChannelMap = absl::flat_hash_map<std::string, ChannelMetrics>;
+
+  // Counts a received message and times its dispatch to JS until the scope
+  // ends. |channel| must outlive the scope.
+  class ScopedDispatch {
+   public:
+    ScopedDispatch(std::string_view channel, size_t bytes);
+    ~ScopedDispatch();
+
+    // disable copy
+    ScopedDispatch(const ScopedDispatch&) = delete;
+    ScopedDispatch& operator=(const ScopedDispatch&) = delete;
+
+   private:
+    const std::string_view channel_;
+    const base::TimeTicks start_time_;
+  };
+
+  static IpcMetrics* GetInstance();
+
+  // disable copy
+  IpcMetrics(const IpcMetrics&) = delete;
+  IpcMetrics& operator=(const IpcMetrics&) = delete;
+
+  // Counts a message of |bytes| serialized bytes. A received message must be
+  // recorded from the task that dispatches it, whose time in the UI thread's
+  // queue is counted as the message's queue time.
+  void RecordMessage(Direction direction,
+                     std::string_view channel,
+                     size_t bytes);
+  void RecordHandlerTime(std::string_view channel, base::TimeDelta time);
+
+  const ChannelMap& received() const { return received_; }
+  const ChannelMap& sent() const { return sent_; }
+
+  void Reset();
+
+ private:
+  friend class base::NoDestructor<IpcMetrics>;
+
+  IpcMetrics();
+  ~IpcMetrics();
+
+  ChannelMetrics& GetChannelMetrics(Direction direction,
+                                    std::string_view channel);
+
+  ChannelMap received_;
+  ChannelMap sent_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_API_IPC_METRICS_H_
@@ -56,6 +56,22 @@ void ElectronApiIPCHandlerImpl::Message(bool internal,
     session->Get()->Message(event_object, channel, std::move(arguments));
   }
 }
+
+void ElectronApiIPCHandlerImpl::MessageBatch(
+    std::vector<mojom::BatchedMessagePtr> messages) {
+  gin::WeakCell<api::Session>* session = GetSession();
+  if (session && session->Get()) {
+    v8::Isolate* isolate = electron::JavascriptEnvironment::GetIsolate();
+    v8::HandleScope handle_scope(isolate);
+    auto* event = MakeIPCEvent(isolate, session->Get(), false);
+    if (!event)
+      return;
+    v8::Local<v8::Object> event_object =
+        event->GetWrapper(isolate).ToLocalChecked();
+    session->Get()->MessageBatch(event_object, std::move(messages));
+  }
+}
+
 void ElectronApiIPCHandlerImpl::Invoke(bool internal,
                                        const std::string& channel,
                                        blink::CloneableMessage arguments,
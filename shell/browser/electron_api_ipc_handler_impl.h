@@ -6,6 +6,7 @@
 #define ELECTRON_SHELL_BROWSER_ELECTRON_API_IPC_HANDLER_IMPL_H_
 
 #include <string>
+#include <vector>
 
 #include "base/memory/weak_ptr.h"
 #include "content/public/browser/global_routing_id.h"
@@ -44,6 +45,7 @@ class ElectronApiIPCHandlerImpl : public mojom::ElectronApiIPC,
   void Message(bool internal,
                const std::string& channel,
                blink::CloneableMessage arguments) override;
+  void MessageBatch(std::vector<mojom::BatchedMessagePtr> messages) override;
   void Invoke(bool internal,
               const std::string& channel,
               blink::CloneableMessage arguments,
@@ -84,6 +84,21 @@ void ElectronApiSWIPCHandlerImpl::Message(bool internal,
   }
 }
 
+void ElectronApiSWIPCHandlerImpl::MessageBatch(
+    std::vector<mojom::BatchedMessagePtr> messages) {
+  gin::WeakCell<api::Session>* session = GetSession();
+  if (session && session->Get()) {
+    v8::Isolate* isolate = electron::JavascriptEnvironment::GetIsolate();
+    v8::HandleScope handle_scope(isolate);
+    auto* event = MakeIPCEvent(isolate, session->Get(), false);
+    if (!event)
+      return;
+    v8::Local<v8::Object> event_object =
+        event->GetWrapper(isolate).ToLocalChecked();
+    session->Get()->MessageBatch(event_object, std::move(messages));
+  }
+}
+
 void ElectronApiSWIPCHandlerImpl::Invoke(bool internal,
                                          const std::string& channel,
                                          blink::CloneableMessage arguments,
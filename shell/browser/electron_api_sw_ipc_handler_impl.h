@@ -6,6 +6,7 @@
 #define ELECTRON_SHELL_BROWSER_ELECTRON_API_SW_IPC_HANDLER_IMPL_H_
 
 #include <string>
+#include <vector>
 
 #include "base/memory/weak_ptr.h"
 #include "content/public/browser/browser_thread.h"
@@ -53,6 +54,7 @@ class ElectronApiSWIPCHandlerImpl : public mojom::ElectronApiIPC,
   void Message(bool internal,
                const std::string& channel,
                blink::CloneableMessage arguments) override;
+  void MessageBatch(std::vector<mojom::BatchedMessagePtr> messages) override;
   void Invoke(bool internal,
               const std::string& channel,
               blink::CloneableMessage arguments,
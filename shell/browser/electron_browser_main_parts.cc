@@ -177,7 +177,7 @@ ElectronBrowserMainParts::ElectronBrowserMainParts()
       node_bindings_{
           NodeBindings::Create(NodeBindings::BrowserEnvironment::kBrowser)},
       electron_bindings_{
-          std::make_unique<ElectronBindings>(node_bindings_->uv_loop())},
+          std::make_unique<ElectronBindings>(node_bindings_.get())},
       browser_{std::make_unique<Browser>()} {
   DCHECK(!self_) << "Cannot have two ElectronBrowserMainParts";
   self_ = this;
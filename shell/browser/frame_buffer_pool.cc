@@ -0,0 +1,152 @@
+// Copyright (c) 2026 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/frame_buffer_pool.h"
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "base/check.h"
+#include "base/containers/heap_array.h"
+#include "base/functional/bind.h"
+#include "base/memory/ptr_util.h"
+#include "base/task/thread_pool.h"
+#include "base/task/thread_pool/thread_pool_instance.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkImageInfo.h"
+
+namespace electron {
+
+struct FrameBufferPool::Buffer {
+  base::HeapArray<uint8_t> data;
+  // When the buffer last returned to the pool.
+  base::TimeTicks released_at;
+};
+
+// static
+FrameBufferPool* FrameBufferPool::GetInstance() {
+  static base::NoDestructor<FrameBufferPool> instance;
+  return instance.get();
+}
+
+FrameBufferPool::FrameBufferPool() = default;
+
+FrameBufferPool::~FrameBufferPool() = default;
+
+void FrameBufferPool::AllocPixels(SkBitmap* bitmap, const SkImageInfo& info) {
+  if (info.isEmpty()) {
+    CHECK(bitmap->setInfo(info));
+    return;
+  }
+
+  const size_t size = info.computeMinByteSize();
+  CHECK(!SkImageInfo::ByteSizeOverflowed(size));
+
+  std::unique_ptr<Buffer> buffer;
+  {
+    base::AutoLock auto_lock(lock_);
+    if (auto it = free_buffers_.find(size); it != free_buffers_.end()) {
+      buffer = std::move(it->second.back());
+      it->second.pop_back();
+      if (it->second.empty())
+        free_buffers_.erase(it);
+      --metrics_.free_buffers;
+      metrics_.free_bytes -= size;
+      ++metrics_.hits;
+    } else {
+      ++metrics_.misses;
+    }
+  }
+  if (!buffer)
+    buffer = std::make_unique<Buffer>(base::HeapArray<uint8_t>::Uninit(size));
+
+  void* const pixels = buffer->data.data();
+  CHECK(bitmap->installPixels(
+      info, pixels, info.minRowBytes(),
+      [](void* addr, void* context) {
+        GetInstance()->Release(
+            base::WrapUnique(static_cast<Buffer*>(context)));
+      },
+      buffer.release()));
+}
+
+FrameBufferPool::Metrics FrameBufferPool::GetMetrics() const {
+  base::AutoLock auto_lock(lock_);
+  return metrics_;
+}
+
+void FrameBufferPool::Release(std::unique_ptr<Buffer> buffer) {
+  const size_t size = buffer->data.size();
+
+  base::AutoLock auto_lock(lock_);
+  auto& buffers = free_buffers_[size];
+  if (buffers.size() >= kMaxFreeBuffersPerSize ||
+      metrics_.free_bytes + size > kMaxFreeBytes) {
+    if (buffers.empty())
+      free_buffers_.erase(size);
+    return;
+  }
+  buffer->released_at = base::TimeTicks::Now();
+  buffers.push_back(std::move(buffer));
+  ++metrics_.free_buffers;
+  metrics_.free_bytes += size;
+  if (!trim_scheduled_)
+    ScheduleTrim(kIdleTimeout);
+}
+
+void FrameBufferPool::TrimIdleBuffers() {
+  // Freed after the lock is released.
+  std::vector<std::unique_ptr<Buffer>> idle_buffers;
+
+  base::AutoLock auto_lock(lock_);
+  trim_scheduled_ = false;
+
+  const base::TimeTicks now = base::TimeTicks::Now();
+  std::optional<base::TimeTicks> next_expiry;
+  for (auto it = free_buffers_.begin(); it != free_buffers_.end();) {
+    auto& buffers = it->second;
+    // Buffers are taken from the back, so the front ones have been idle the
+    // longest.
+    auto idle_end = std::ranges::find_if(buffers, [&](const auto& buffer) {
+      return now - buffer->released_at < kIdleTimeout;
+    });
+    for (auto idle = buffers.begin(); idle != idle_end; ++idle) {
+      --metrics_.free_buffers;
+      metrics_.free_bytes -= (*idle)->data.size();
+      idle_buffers.push_back(std::move(*idle));
+    }
+    buffers.erase(buffers.begin(), idle_end);
+
+    if (buffers.empty()) {
+      free_buffers_.erase(it++);
+      continue;
+    }
+    const base::TimeTicks expiry = buffers.front()->released_at + kIdleTimeout;
+    next_expiry = next_expiry ? std::min(*next_expiry, expiry) : expiry;
+    ++it;
+  }
+
+  if (next_expiry)
+    ScheduleTrim(*next_expiry - now);
+}
+
+void FrameBufferPool::ScheduleTrim(base::TimeDelta delay) {
+  // Frames can be released while shutting down, after the thread pool is
+  // gone; nothing needs trimming then.
+  if (!base::ThreadPoolInstance::Get())
+    return;
+
+  trim_scheduled_ = true;
+  base::ThreadPool::PostDelayedTask(
+      FROM_HERE,
+      {base::TaskPriority::BEST_EFFORT,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&FrameBufferPool::TrimIdleBuffers,
+                     base::Unretained(this)),
+      delay);
+}
+
+}  // namespace electron
@@ -0,0 +1,83 @@
+// Copyright (c) 2026 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_FRAME_BUFFER_POOL_H_
+#define ELECTRON_SHELL_BROWSER_FRAME_BUFFER_POOL_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
+#include "base/time/time.h"
+#include "third_party/abseil-cpp/absl/container/flat_hash_map.h"
+
+class SkBitmap;
+struct SkImageInfo;
+
+namespace electron {
+
+// Recycles the pixel memory of the frames painted by offscreen rendering and
+// captured by frame subscriptions. A frame's buffer returns to the pool once
+// the last bitmap referencing it, usually held by a NativeImage in JS, is
+// gone, and is reused for the next frame of the same size. Buffers that are
+// not reused within kIdleTimeout are freed, so that the pool does not stay
+// resident once painting stops.
+class FrameBufferPool {
+ public:
+  struct Metrics {
+    uint64_t hits = 0U;
+    uint64_t misses = 0U;
+    size_t free_buffers = 0U;
+    size_t free_bytes = 0U;
+  };
+
+  // The pool holds at most this many free buffers of a size, and this many
+  // bytes of free buffers in total. Buffers released past these limits are
+  // freed.
+  static constexpr size_t kMaxFreeBuffersPerSize = 4U;
+  static constexpr size_t kMaxFreeBytes = 128U * 1024U * 1024U;
+  static constexpr base::TimeDelta kIdleTimeout = base::Seconds(5);
+
+  static FrameBufferPool* GetInstance();
+
+  // disable copy
+  FrameBufferPool(const FrameBufferPool&) = delete;
+  FrameBufferPool& operator=(const FrameBufferPool&) = delete;
+
+  // Like SkBitmap::allocPixels(), but the pixels are taken from the pool when
+  // a buffer of that size is free. Their contents are undefined.
+  void AllocPixels(SkBitmap* bitmap, const SkImageInfo& info);
+
+  Metrics GetMetrics() const;
+
+ private:
+  friend class base::NoDestructor<FrameBufferPool>;
+
+  struct Buffer;
+
+  FrameBufferPool();
+  ~FrameBufferPool();
+
+  // Can be called on any thread, as the last reference to the pixels isn't
+  // necessarily dropped on the UI thread.
+  void Release(std::unique_ptr<Buffer> buffer);
+
+  // Frees the buffers that have been in the pool for kIdleTimeout, and
+  // schedules itself again while buffers remain.
+  void TrimIdleBuffers();
+  void ScheduleTrim(base::TimeDelta delay) EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  mutable base::Lock lock_;
+  absl::flat_hash_map<size_t, std::vector<std::unique_ptr<Buffer>>>
+      free_buffers_ GUARDED_BY(lock_);
+  Metrics metrics_ GUARDED_BY(lock_);
+  bool trim_scheduled_ GUARDED_BY(lock_) = false;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_FRAME_BUFFER_POOL_H_
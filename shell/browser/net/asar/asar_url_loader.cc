@@ -6,11 +6,14 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
+#include "base/containers/span.h"
+#include "base/strings/string_view_util.h"
 #include "base/task/thread_pool.h"
 #include "content/public/browser/file_url_loader.h"
 #include "mojo/public/cpp/bindings/receiver.h"
@@ -55,6 +58,78 @@ static_assert(kDefaultFileUrlPipeSize >= net::kMaxBytesToSniff,
               "Default file data pipe size must be at least as large as a MIME-"
               "type sniffing buffer.");
 
+// Pipe size used when serving from the archive's mapping. Files up to this
+// size are written to the pipe in a single step.
+constexpr uint64_t kMaxMappedFilePipeSize = 512 * 1024;
+
+// Copies a range of a packed file out of the archive's mapping. The integrity
+// blocks are validated a chunk at a time, as the chunks are written to the
+// pipe on the producer's sequence, so that the first bytes of a large file
+// are sent without hashing all of it first.
+class ArchiveFileDataSource : public mojo::DataPipeProducer::DataSource {
+ public:
+  ArchiveFileDataSource(std::shared_ptr<Archive> archive,
+                        const Archive::FileInfo& info,
+                        uint64_t offset,
+                        uint64_t length)
+      : archive_{std::move(archive)},
+        info_{info},
+        offset_{offset},
+        length_{length} {}
+  ~ArchiveFileDataSource() override = default;
+
+  // disable copy
+  ArchiveFileDataSource(const ArchiveFileDataSource&) = delete;
+  ArchiveFileDataSource& operator=(const ArchiveFileDataSource&) = delete;
+
+  // mojo::DataPipeProducer::DataSource
+  uint64_t GetLength() const override { return length_; }
+
+  ReadResult Read(uint64_t offset, base::span<char> buffer) override {
+    ReadResult result;
+    if (offset >= length_)
+      return result;
+
+    const uint64_t chunk_size =
+        std::min<uint64_t>(buffer.size(), length_ - offset);
+    const std::optional<base::span<const uint8_t>> chunk =
+        archive_->GetFileContents(info_, offset_ + offset, chunk_size);
+    if (!chunk) {
+      result.result = MOJO_RESULT_UNKNOWN;
+      return result;
+    }
+    buffer.copy_prefix_from(base::as_chars(*chunk));
+    result.bytes_read = chunk->size();
+    return result;
+  }
+
+ private:
+  const std::shared_ptr<Archive> archive_;
+  const Archive::FileInfo info_;
+  const uint64_t offset_;
+  const uint64_t length_;
+};
+
+// Handles a simple Range header for a single range. Returns false if the
+// request has a Range header that cannot be satisfied for a file of |size|.
+bool GetByteRange(const network::ResourceRequest& request,
+                  uint64_t size,
+                  net::HttpByteRange* byte_range) {
+  auto range_header =
+      request.headers.GetHeader(net::HttpRequestHeaders::kRange);
+  if (!range_header)
+    return true;
+
+  std::vector<net::HttpByteRange> ranges;
+  if (!net::HttpUtil::ParseRangeHeader(range_header.value(), &ranges) ||
+      ranges.size() != 1) {
+    return false;
+  }
+
+  *byte_range = ranges[0];
+  return byte_range->ComputeBounds(size);
+}
+
 // Modified from the |FileURLLoader| in |file_url_loader_factory.cc|, to serve
 // asar files instead of normal files.
 class AsarURLLoader : public network::mojom::URLLoader {
@@ -132,6 +207,10 @@ class AsarURLLoader : public network::mojom::URLLoader {
     }
     bool is_verifying_file = info.integrity.has_value();
 
+    // Packed files are normally served from the archive's mapping.
+    if (!info.unpacked && StartFromMapping(request, path, archive, info, head))
+      return;
+
     // For unpacked path, read like normal file.
     base::FilePath real_path;
     if (info.unpacked) {
@@ -178,26 +257,10 @@ class AsarURLLoader : public network::mojom::URLLoader {
       return;
     }
 
-    auto range_header =
-        request.headers.GetHeader(net::HttpRequestHeaders::kRange);
     net::HttpByteRange byte_range;
-    if (range_header) {
-      // Handle a simple Range header for a single range.
-      std::vector<net::HttpByteRange> ranges;
-      bool fail = false;
-      if (net::HttpUtil::ParseRangeHeader(range_header.value(), &ranges) &&
-          ranges.size() == 1) {
-        byte_range = ranges[0];
-        if (!byte_range.ComputeBounds(info.size))
-          fail = true;
-      } else {
-        fail = true;
-      }
-
-      if (fail) {
-        OnClientComplete(net::ERR_REQUEST_RANGE_NOT_SATISFIABLE);
-        return;
-      }
+    if (!GetByteRange(request, info.size, &byte_range)) {
+      OnClientComplete(net::ERR_REQUEST_RANGE_NOT_SATISFIABLE);
+      return;
     }
 
     uint64_t first_byte_to_send = 0U;
@@ -336,6 +399,84 @@ class AsarURLLoader : public network::mojom::URLLoader {
         base::BindOnce(&AsarURLLoader::OnFileWritten, base::Unretained(this)));
   }
 
+  // Serves a packed file straight from the archive's mapping, skipping the
+  // intermediate reads into buffers. Returns false without responding if the
+  // archive could not be mapped, in which case the file should be streamed
+  // from disk instead.
+  bool StartFromMapping(const network::ResourceRequest& request,
+                        const base::FilePath& path,
+                        std::shared_ptr<Archive> archive,
+                        const Archive::FileInfo& info,
+                        network::mojom::URLResponseHeadPtr& head) {
+    net::HttpByteRange byte_range;
+    if (!GetByteRange(request, info.size, &byte_range)) {
+      OnClientComplete(net::ERR_REQUEST_RANGE_NOT_SATISFIABLE);
+      return true;
+    }
+
+    uint64_t first_byte_to_send = 0U;
+    uint64_t total_bytes_to_send = info.size;
+    if (byte_range.IsValid()) {
+      first_byte_to_send = byte_range.first_byte_position();
+      total_bytes_to_send =
+          byte_range.last_byte_position() - first_byte_to_send + 1;
+    }
+
+    // Maps the archive without validating anything yet: the data source
+    // validates each chunk as it is sent.
+    if (!archive->GetFileContents(info, first_byte_to_send, 0U))
+      return false;
+
+    if (!net::GetMimeTypeFromFile(path, &head->mime_type)) {
+      const std::optional<base::span<const uint8_t>> head_bytes =
+          archive->GetFileContents(
+              info, 0U,
+              std::min<uint64_t>(net::kMaxBytesToSniff, info.size));
+      if (!head_bytes)
+        return false;
+      std::string new_type;
+      net::SniffMimeType(base::as_string_view(*head_bytes), request.url,
+                         head->mime_type,
+                         net::ForceSniffFileUrlsForHtml::kDisabled, &new_type);
+      head->mime_type.assign(new_type);
+      head->did_mime_sniff = true;
+    }
+
+    mojo::ScopedDataPipeProducerHandle producer_handle;
+    mojo::ScopedDataPipeConsumerHandle consumer_handle;
+    const auto pipe_size = static_cast<uint32_t>(std::clamp<uint64_t>(
+        total_bytes_to_send, kDefaultFileUrlPipeSize, kMaxMappedFilePipeSize));
+    if (mojo::CreateDataPipe(pipe_size, producer_handle, consumer_handle) !=
+        MOJO_RESULT_OK) {
+      OnClientComplete(net::ERR_FAILED);
+      return true;
+    }
+
+    total_bytes_written_ = total_bytes_to_send;
+    head->content_length = base::saturated_cast<int64_t>(total_bytes_to_send);
+    if (head->headers) {
+      head->headers->AddHeader(net::HttpRequestHeaders::kContentType,
+                               head->mime_type);
+    }
+    client_->OnReceiveResponse(std::move(head), std::move(consumer_handle),
+                               std::nullopt);
+
+    if (total_bytes_to_send == 0) {
+      OnFileWritten(MOJO_RESULT_OK);
+      return true;
+    }
+
+    // The data source keeps the archive, and so its mapping, alive.
+    data_producer_ =
+        std::make_unique<mojo::DataPipeProducer>(std::move(producer_handle));
+    data_producer_->Write(
+        std::make_unique<ArchiveFileDataSource>(std::move(archive), info,
+                                                first_byte_to_send,
+                                                total_bytes_to_send),
+        base::BindOnce(&AsarURLLoader::OnFileWritten, base::Unretained(this)));
+    return true;
+  }
+
   void OnConnectionError() {
     receiver_.reset();
     MaybeDeleteSelf();
@@ -68,7 +68,9 @@ void LayeredWindowUpdater::Draw(const gfx::Rect& damage_rect,
 
   if (active_ && canvas_->peekPixels(&pixmap)) {
     bitmap.installPixels(pixmap);
-    callback_.Run(damage_rect, bitmap, {});
+    const base::TimeTicks now = base::TimeTicks::Now();
+    callback_.Run(damage_rect, bitmap, {},
+                  {.begin_frame_time = now, .capture_time = now});
   }
 
   std::move(draw_callback).Run();
@@ -7,6 +7,7 @@
 #define ELECTRON_SHELL_BROWSER_OSR_OSR_PAINT_EVENT_H
 
 #include "base/functional/callback_helpers.h"
+#include "base/time/time.h"
 #include "content/public/common/widget_type.h"
 #include "media/base/video_types.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
@@ -108,8 +109,21 @@ struct OffscreenSharedTextureValue {
 
 typedef std::optional<OffscreenSharedTextureValue> OffscreenSharedTexture;
 
-typedef base::RepeatingCallback<
-    void(const gfx::Rect&, const SkBitmap&, const OffscreenSharedTexture&)>
+struct OffscreenFrameInfo {
+  // The begin-frame time the frame was produced for.
+  base::TimeTicks begin_frame_time;
+
+  // When the frame finished being captured.
+  base::TimeTicks capture_time;
+
+  // The number of frames that frame pacing dropped in favor of this one.
+  uint32_t dropped_frames = 0U;
+};
+
+typedef base::RepeatingCallback<void(const gfx::Rect&,
+                                     const SkBitmap&,
+                                     const OffscreenSharedTexture&,
+                                     const OffscreenFrameInfo&)>
     OnPaintCallback;
 
 }  // namespace electron
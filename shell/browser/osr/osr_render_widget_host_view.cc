@@ -32,6 +32,7 @@
 #include "content/public/browser/context_factory.h"
 #include "content/public/browser/gpu_data_manager.h"
 #include "content/public/browser/render_process_host.h"
+#include "shell/browser/frame_buffer_pool.h"
 #include "shell/browser/osr/osr_host_display_client.h"
 #include "third_party/blink/public/common/input/web_input_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
@@ -43,6 +44,7 @@
 #include "ui/events/event_constants.h"
 #include "ui/gfx/geometry/dip_util.h"
 #include "ui/gfx/geometry/size_conversions.h"
+#include "ui/gfx/geometry/skia_conversions.h"
 #include "ui/gfx/image/image_skia.h"
 #include "ui/gfx/native_ui_types.h"
 #include "ui/gfx/skbitmap_operations.h"
@@ -162,6 +164,9 @@ OffScreenRenderWidgetHostView::OffScreenRenderWidgetHostView(
     bool offscreen_use_shared_texture,
     const std::string& offscreen_shared_texture_pixel_format,
     float offscreen_device_scale_factor,
+    bool offscreen_zero_copy,
+    bool offscreen_dirty_rect_only,
+    bool offscreen_frame_pacing,
     bool painting,
     int frame_rate,
     const OnPaintCallback& callback,
@@ -176,6 +181,9 @@ OffScreenRenderWidgetHostView::OffScreenRenderWidgetHostView(
       offscreen_shared_texture_pixel_format_(
           offscreen_shared_texture_pixel_format),
       offscreen_device_scale_factor_(offscreen_device_scale_factor),
+      offscreen_zero_copy_(offscreen_zero_copy),
+      offscreen_dirty_rect_only_(offscreen_dirty_rect_only),
+      offscreen_frame_pacing_(offscreen_frame_pacing),
       callback_(callback),
       frame_rate_(frame_rate),
       size_(initial_size),
@@ -244,6 +252,7 @@ void OffScreenRenderWidgetHostView::OnLocalSurfaceIdChanged(
 }
 
 OffScreenRenderWidgetHostView::~OffScreenRenderWidgetHostView() {
+  ReleasePendingTexture();
   ReleaseCompositor();
   root_layer_.reset();
 
@@ -549,8 +558,9 @@ OffScreenRenderWidgetHostView::CreateViewForWidget(
   return new OffScreenRenderWidgetHostView(
       transparent_, offscreen_use_shared_texture_,
       offscreen_shared_texture_pixel_format_, offscreen_device_scale_factor_,
-      true, embedder_host_view->frame_rate(), callback_, render_widget_host,
-      embedder_host_view, size());
+      offscreen_zero_copy_, offscreen_dirty_rect_only_,
+      offscreen_frame_pacing_, true, embedder_host_view->frame_rate(),
+      callback_, render_widget_host, embedder_host_view, size());
 }
 
 const viz::FrameSinkId& OffScreenRenderWidgetHostView::GetFrameSinkId() const {
@@ -662,15 +672,39 @@ uint64_t OffScreenRenderWidgetHostView::GetNSViewId() const {
 void OffScreenRenderWidgetHostView::OnPaint(
     const gfx::Rect& damage_rect,
     const SkBitmap& bitmap,
-    const OffscreenSharedTexture& texture) {
+    const OffscreenSharedTexture& texture,
+    const OffscreenFrameInfo& frame_info) {
+  frame_info_ = frame_info;
+
   if (texture.has_value()) {
-    callback_.Run(damage_rect, {}, texture);
+    if (offscreen_frame_pacing_ && frame_in_flight_) {
+      // Only the latest texture is kept until the consumer catches up.
+      if (frame_pending_)
+        ++dropped_frames_;
+      ReleasePendingTexture();
+      pending_texture_ = texture;
+      pending_damage_rect_.Union(damage_rect);
+      frame_pending_ = true;
+      return;
+    }
+    DeliverTexture(damage_rect, *texture);
     return;
   }
 
-  backing_ = std::make_unique<SkBitmap>();
-  backing_->allocN32Pixels(bitmap.width(), bitmap.height(), !transparent_);
-  bitmap.readPixels(backing_->pixmap());
+  // Captured frames are immutable and their buffers aren't recycled while
+  // referenced, so they can be kept instead of copied. The software output
+  // device paints into the same bitmap every time, so it's always copied.
+  if (offscreen_zero_copy_ && bitmap.isImmutable()) {
+    backing_ = std::make_unique<SkBitmap>(bitmap);
+  } else {
+    backing_ = std::make_unique<SkBitmap>();
+    FrameBufferPool::GetInstance()->AllocPixels(
+        backing_.get(),
+        SkImageInfo::MakeN32(bitmap.width(), bitmap.height(),
+                             transparent_ ? kPremul_SkAlphaType
+                                          : kOpaque_SkAlphaType));
+    bitmap.readPixels(backing_->pixmap());
+  }
 
   if (IsPopupWidget() && parent_callback_) {
     parent_callback_.Run(this->popup_position_);
@@ -687,27 +721,53 @@ gfx::Size OffScreenRenderWidgetHostView::SizeInPixels() {
 
 void OffScreenRenderWidgetHostView::CompositeFrame(
     const gfx::Rect& damage_rect) {
+  // While the consumer is busy with the last frame, the frames painted in the
+  // meantime are merged into one that is composited once it's done.
+  if (offscreen_frame_pacing_ && frame_in_flight_) {
+    if (frame_pending_)
+      ++dropped_frames_;
+    pending_damage_rect_.Union(damage_rect);
+    frame_pending_ = true;
+    return;
+  }
+
   HoldResize();
 
   gfx::Size size_in_pixels = SizeInPixels();
+  gfx::Rect dirty_rect =
+      gfx::IntersectRects(gfx::Rect(size_in_pixels), damage_rect);
+
+  // The area of the view that the painted frame covers, either the whole view
+  // or only its dirty part.
+  gfx::Rect frame_rect =
+      offscreen_dirty_rect_only_ ? dirty_rect : gfx::Rect(size_in_pixels);
 
   SkBitmap frame;
 
   // Optimize for the case when there is no popup
   if (proxy_views_.empty() && !popup_host_view_) {
-    frame = GetBacking();
-  } else {
+    if (offscreen_dirty_rect_only_) {
+      // Shares the backing's pixels.
+      GetBacking().extractSubset(&frame, gfx::RectToSkIRect(frame_rect));
+    } else {
+      frame = GetBacking();
+    }
+  } else if (!frame_rect.IsEmpty()) {
     float sf = GetDeviceScaleFactor();
-    frame.allocN32Pixels(size_in_pixels.width(), size_in_pixels.height(),
-                         false);
+    FrameBufferPool::GetInstance()->AllocPixels(
+        &frame, SkImageInfo::MakeN32Premul(frame_rect.width(),
+                                           frame_rect.height()));
     if (!GetBacking().drawsNothing()) {
+      // Everything is drawn relative to the frame, and only the parts that
+      // overlap it are written.
       SkCanvas canvas(frame);
-      canvas.writePixels(GetBacking(), 0, 0);
+      canvas.writePixels(GetBacking(), -frame_rect.x(), -frame_rect.y());
 
       if (popup_host_view_ && !popup_host_view_->GetBacking().drawsNothing()) {
         gfx::Rect rect = popup_host_view_->popup_position_;
         gfx::Point origin_in_pixels =
-            gfx::ToFlooredPoint(gfx::ConvertPointToPixels(rect.origin(), sf));
+            gfx::ToFlooredPoint(gfx::ConvertPointToPixels(rect.origin(), sf)) -
+            frame_rect.OffsetFromOrigin();
         canvas.writePixels(popup_host_view_->GetBacking(), origin_in_pixels.x(),
                            origin_in_pixels.y());
       }
@@ -715,19 +775,58 @@ void OffScreenRenderWidgetHostView::CompositeFrame(
       for (auto* proxy_view : proxy_views_) {
         gfx::Rect rect = proxy_view->bounds();
         gfx::Point origin_in_pixels =
-            gfx::ToFlooredPoint(gfx::ConvertPointToPixels(rect.origin(), sf));
+            gfx::ToFlooredPoint(gfx::ConvertPointToPixels(rect.origin(), sf)) -
+            frame_rect.OffsetFromOrigin();
         canvas.writePixels(*proxy_view->bitmap(), origin_in_pixels.x(),
                            origin_in_pixels.y());
       }
     }
   }
 
-  callback_.Run(gfx::IntersectRects(gfx::Rect(size_in_pixels), damage_rect),
-                frame, {});
+  frame_in_flight_ = offscreen_frame_pacing_;
+  frame_info_.dropped_frames = std::exchange(dropped_frames_, 0U);
+  callback_.Run(dirty_rect, frame, {}, frame_info_);
 
   ReleaseResize();
 }
 
+void OffScreenRenderWidgetHostView::AcknowledgeFrame() {
+  if (!frame_in_flight_)
+    return;
+  frame_in_flight_ = false;
+
+  if (!frame_pending_)
+    return;
+  frame_pending_ = false;
+
+  const gfx::Rect damage_rect = std::exchange(pending_damage_rect_, {});
+  if (pending_texture_.has_value()) {
+    const OffscreenSharedTextureValue texture = *pending_texture_;
+    pending_texture_.reset();
+    DeliverTexture(damage_rect, texture);
+  } else {
+    CompositeFrame(damage_rect);
+  }
+}
+
+void OffScreenRenderWidgetHostView::DeliverTexture(
+    const gfx::Rect& damage_rect,
+    const OffscreenSharedTextureValue& texture) {
+  frame_in_flight_ = offscreen_frame_pacing_;
+  frame_info_.dropped_frames = std::exchange(dropped_frames_, 0U);
+  callback_.Run(damage_rect, {}, texture, frame_info_);
+}
+
+void OffScreenRenderWidgetHostView::ReleasePendingTexture() {
+  if (!pending_texture_.has_value())
+    return;
+  // Nothing else references the releaser of a texture that was never
+  // delivered, so releasing it returns the frame to the capturer.
+  OffscreenReleaserHolder* releaser_holder = pending_texture_->releaser_holder;
+  pending_texture_.reset();
+  delete releaser_holder;
+}
+
 void OffScreenRenderWidgetHostView::OnPopupPaint(const gfx::Rect& damage_rect) {
   InvalidateBounds(gfx::ToEnclosingRect(
       gfx::ConvertRectToPixels(damage_rect, GetDeviceScaleFactor())));
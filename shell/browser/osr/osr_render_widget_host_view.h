@@ -74,6 +74,9 @@ class OffScreenRenderWidgetHostView
       bool offscreen_use_shared_texture,
       const std::string& offscreen_shared_texture_pixel_format,
       float offscreen_device_scale_factor,
+      bool offscreen_zero_copy,
+      bool offscreen_dirty_rect_only,
+      bool offscreen_frame_pacing,
       bool painting,
       int frame_rate,
       const OnPaintCallback& callback,
@@ -213,7 +216,8 @@ class OffScreenRenderWidgetHostView
 
   void OnPaint(const gfx::Rect& damage_rect,
                const SkBitmap& bitmap,
-               const OffscreenSharedTexture& texture);
+               const OffscreenSharedTexture& texture,
+               const OffscreenFrameInfo& frame_info);
   void OnPopupPaint(const gfx::Rect& damage_rect);
   void OnProxyViewPaint(const gfx::Rect& damage_rect) override;
 
@@ -221,6 +225,10 @@ class OffScreenRenderWidgetHostView
 
   void CompositeFrame(const gfx::Rect& damage_rect);
 
+  // With frame pacing, called by the consumer once it is done with the last
+  // delivered frame, to deliver the frames painted in the meantime.
+  void AcknowledgeFrame();
+
   bool IsPopupWidget() const {
     return widget_type_ == content::WidgetType::kPopup;
   }
@@ -273,6 +281,9 @@ class OffScreenRenderWidgetHostView
 
  private:
   void ReleaseCompositor();
+  void DeliverTexture(const gfx::Rect& damage_rect,
+                      const OffscreenSharedTextureValue& texture);
+  void ReleasePendingTexture();
   void SetupFrameRate(bool force);
   void ResizeRootLayer(bool force);
 
@@ -295,6 +306,9 @@ class OffScreenRenderWidgetHostView
   const bool offscreen_use_shared_texture_;
   const std::string offscreen_shared_texture_pixel_format_;
   float offscreen_device_scale_factor_;
+  const bool offscreen_zero_copy_;
+  const bool offscreen_dirty_rect_only_;
+  const bool offscreen_frame_pacing_;
 
   OnPaintCallback callback_;
   OnPopupPaintCallback parent_callback_;
@@ -346,6 +360,18 @@ class OffScreenRenderWidgetHostView
 
   std::unique_ptr<SkBitmap> backing_;
 
+  // The info of the latest captured frame.
+  OffscreenFrameInfo frame_info_;
+
+  // Frame pacing state: whether the consumer has yet to acknowledge the last
+  // delivered frame, whether frames were painted in the meantime and how many
+  // of them were dropped in favor of the latest one.
+  bool frame_in_flight_ = false;
+  bool frame_pending_ = false;
+  gfx::Rect pending_damage_rect_;
+  OffscreenSharedTexture pending_texture_;
+  uint32_t dropped_frames_ = 0U;
+
   base::WeakPtrFactory<OffScreenRenderWidgetHostView> weak_ptr_factory_{this};
 };
 
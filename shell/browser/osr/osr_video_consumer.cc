@@ -100,6 +100,11 @@ void OffScreenVideoConsumer::OnFrameCaptured(
   // there's no need to call the callbacks, see in_flight_frame_delivery.cc
   // The destructor will call Done for us once the pipe closed.
 
+  const base::TimeTicks now = base::TimeTicks::Now();
+  const OffscreenFrameInfo frame_info{
+      .begin_frame_time = info->metadata.reference_time.value_or(now),
+      .capture_time = info->metadata.capture_end_time.value_or(now)};
+
   // Offscreen using GPU shared texture
   if (view_->offscreen_use_shared_texture()) {
     CHECK(data->is_gpu_memory_buffer_handle());
@@ -144,7 +149,7 @@ void OffScreenVideoConsumer::OnFrameCaptured(
     texture.releaser_holder = new OffscreenReleaserHolder(std::move(gmb_handle),
                                                           std::move(callbacks));
 
-    callback_.Run(content_rect, {}, std::move(texture));
+    callback_.Run(content_rect, {}, std::move(texture), frame_info);
     return;
   }
 
@@ -203,7 +208,7 @@ void OffScreenVideoConsumer::OnFrameCaptured(
     update_rect = content_rect;
   }
 
-  callback_.Run(*update_rect, bitmap, {});
+  callback_.Run(*update_rect, bitmap, {}, frame_info);
 }
 
 }  // namespace electron
@@ -18,12 +18,18 @@ OffScreenWebContentsView::OffScreenWebContentsView(
     bool offscreen_use_shared_texture,
     const std::string& offscreen_shared_texture_pixel_format,
     float offscreen_device_scale_factor,
+    bool offscreen_zero_copy,
+    bool offscreen_dirty_rect_only,
+    bool offscreen_frame_pacing,
     const OnPaintCallback& callback)
     : transparent_(transparent),
       offscreen_use_shared_texture_(offscreen_use_shared_texture),
       offscreen_shared_texture_pixel_format_(
           offscreen_shared_texture_pixel_format),
       offscreen_device_scale_factor_(offscreen_device_scale_factor),
+      offscreen_zero_copy_(offscreen_zero_copy),
+      offscreen_dirty_rect_only_(offscreen_dirty_rect_only),
+      offscreen_frame_pacing_(offscreen_frame_pacing),
       callback_(callback) {
 #if BUILDFLAG(IS_MAC)
   PlatformCreate();
@@ -119,8 +125,9 @@ OffScreenWebContentsView::CreateViewForWidget(
   return new OffScreenRenderWidgetHostView(
       transparent_, offscreen_use_shared_texture_,
       offscreen_shared_texture_pixel_format_, offscreen_device_scale_factor_,
-      painting_, GetFrameRate(), callback_, render_widget_host, nullptr,
-      GetSize());
+      offscreen_zero_copy_, offscreen_dirty_rect_only_,
+      offscreen_frame_pacing_, painting_, GetFrameRate(), callback_,
+      render_widget_host, nullptr, GetSize());
 }
 
 content::RenderWidgetHostViewBase*
@@ -141,8 +148,9 @@ OffScreenWebContentsView::CreateViewForChildWidget(
   return new OffScreenRenderWidgetHostView(
       transparent_, offscreen_use_shared_texture_,
       offscreen_shared_texture_pixel_format_, offscreen_device_scale_factor_,
-      painting_, embedder_host_view->frame_rate(), callback_,
-      render_widget_host, embedder_host_view, GetSize());
+      offscreen_zero_copy_, offscreen_dirty_rect_only_,
+      offscreen_frame_pacing_, painting_, embedder_host_view->frame_rate(),
+      callback_, render_widget_host, embedder_host_view, GetSize());
 }
 
 void OffScreenWebContentsView::RenderViewReady() {
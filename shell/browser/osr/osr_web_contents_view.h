@@ -39,6 +39,9 @@ class OffScreenWebContentsView : public content::WebContentsView,
       bool offscreen_use_shared_texture,
       const std::string& offscreen_shared_texture_pixel_format,
       float offscreen_device_scale_factor,
+      bool offscreen_zero_copy,
+      bool offscreen_dirty_rect_only,
+      bool offscreen_frame_pacing,
       const OnPaintCallback& callback);
   ~OffScreenWebContentsView() override;
 
@@ -115,6 +118,9 @@ class OffScreenWebContentsView : public content::WebContentsView,
   const bool offscreen_use_shared_texture_;
   const std::string offscreen_shared_texture_pixel_format_;
   const float offscreen_device_scale_factor_;
+  const bool offscreen_zero_copy_;
+  const bool offscreen_dirty_rect_only_;
+  const bool offscreen_frame_pacing_;
   bool painting_ = true;
   int frame_rate_ = 60;
   OnPaintCallback callback_;
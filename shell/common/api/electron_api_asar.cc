@@ -2,17 +2,24 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <optional>
 #include <vector>
 
+#include "base/compiler_specific.h"
+#include "base/containers/span.h"
 #include "shell/common/asar/archive.h"
 #include "shell/common/asar/asar_util.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/handle.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/node_util.h"
 
 namespace {
 
+// Number of values statBatch() packs for each path: type, size and offset.
+constexpr size_t kStatBatchStride = 3;
+
 class Archive : public node::ObjectWrap {
  public:
   static v8::Local<v8::FunctionTemplate> CreateFunctionTemplate(
@@ -23,9 +30,11 @@ class Archive : public node::ObjectWrap {
 
     NODE_SET_PROTOTYPE_METHOD(tpl, "getFileInfo", &Archive::GetFileInfo);
     NODE_SET_PROTOTYPE_METHOD(tpl, "stat", &Archive::Stat);
+    NODE_SET_PROTOTYPE_METHOD(tpl, "statBatch", &Archive::StatBatch);
     NODE_SET_PROTOTYPE_METHOD(tpl, "readdir", &Archive::Readdir);
     NODE_SET_PROTOTYPE_METHOD(tpl, "realpath", &Archive::Realpath);
     NODE_SET_PROTOTYPE_METHOD(tpl, "copyFileOut", &Archive::CopyFileOut);
+    NODE_SET_PROTOTYPE_METHOD(tpl, "read", &Archive::Read);
     NODE_SET_PROTOTYPE_METHOD(tpl, "getFdAndValidateIntegrityLater",
                               &Archive::GetFD);
 
@@ -122,6 +131,41 @@ class Archive : public node::ObjectWrap {
     args.GetReturnValue().Set(dict.GetHandle());
   }
 
+  // Stats an array of paths in a single call. Returns a Float64Array holding
+  // [type, size, offset] for each path, with a type of -1 for paths that
+  // don't exist.
+  static void StatBatch(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto* isolate = args.GetIsolate();
+    auto* wrap = node::ObjectWrap::Unwrap<Archive>(args.This());
+    std::vector<base::FilePath> paths;
+    if (!gin::ConvertFromV8(isolate, args[0], &paths)) {
+      args.GetReturnValue().Set(v8::False(isolate));
+      return;
+    }
+
+    const size_t length = paths.size() * kStatBatchStride;
+    v8::Local<v8::ArrayBuffer> buffer =
+        v8::ArrayBuffer::New(isolate, length * sizeof(double));
+    // SAFETY: |buffer| was just allocated to hold |length| doubles.
+    auto results = UNSAFE_BUFFERS(
+        base::span(static_cast<double*>(buffer->Data()), length));
+    for (size_t i = 0; i < paths.size(); ++i) {
+      auto result = results.subspan(i * kStatBatchStride, kStatBatchStride);
+      asar::Archive::Stats stats;
+      if (wrap->archive_ && wrap->archive_->Stat(paths[i], &stats)) {
+        result[0] = static_cast<int>(stats.type);
+        result[1] = stats.size;
+        result[2] = static_cast<double>(stats.offset);
+      } else {
+        result[0] = -1;
+        result[1] = 0;
+        result[2] = 0;
+      }
+    }
+
+    args.GetReturnValue().Set(v8::Float64Array::New(buffer, 0, length));
+  }
+
   // Returns all files under a directory.
   static void Readdir(const v8::FunctionCallbackInfo<v8::Value>& args) {
     auto* isolate = args.GetIsolate();
@@ -176,6 +220,45 @@ class Archive : public node::ObjectWrap {
     args.GetReturnValue().Set(gin::ConvertToV8(isolate, new_path));
   }
 
+  // Reads a packed file out of the mapped archive, as a string when the second
+  // argument is true and as a Buffer otherwise.
+  static void Read(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto* isolate = args.GetIsolate();
+    auto* wrap = node::ObjectWrap::Unwrap<Archive>(args.This());
+    args.GetReturnValue().Set(v8::False(isolate));
+
+    base::FilePath path;
+    if (!gin::ConvertFromV8(isolate, args[0], &path))
+      return;
+
+    asar::Archive::FileInfo info;
+    if (!wrap->archive_ || !wrap->archive_->GetFileInfo(path, &info))
+      return;
+
+    const std::optional<base::span<const uint8_t>> contents =
+        wrap->archive_->GetFileContents(info);
+    if (!contents)
+      return;
+
+    if (args[1]->IsTrue()) {
+      // Decode straight from the mapping. Strings that are too long are left
+      // for the caller to read as a Buffer, which reports the proper error.
+      v8::Local<v8::String> str;
+      if (contents->size() <= v8::String::kMaxLength &&
+          v8::String::NewFromUtf8(
+              isolate, reinterpret_cast<const char*>(contents->data()),
+              v8::NewStringType::kNormal, static_cast<int>(contents->size()))
+              .ToLocal(&str)) {
+        args.GetReturnValue().Set(str);
+      }
+      return;
+    }
+
+    v8::Local<v8::Object> buffer;
+    if (electron::Buffer::Copy(isolate, *contents).ToLocal(&buffer))
+      args.GetReturnValue().Set(buffer);
+  }
+
   // Return the file descriptor.
   static void GetFD(const v8::FunctionCallbackInfo<v8::Value>& args) {
     auto* isolate = args.GetIsolate();
@@ -0,0 +1,399 @@
+// Copyright (c) 2026 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/api/electron_api_shared_ring_buffer.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <new>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+#include "base/compiler_specific.h"
+#include "base/containers/span.h"
+#include "base/functional/bind.h"
+#include "base/memory/unsafe_shared_memory_region.h"
+#include "gin/arguments.h"
+#include "gin/object_template_builder.h"
+#include "shell/common/gin_helper/error_thrower.h"
+#include "shell/common/gin_helper/event_emitter_caller.h"
+#include "shell/common/gin_helper/handle.h"
+#include "shell/common/node_includes.h"
+#include "shell/common/v8_util.h"
+#include "v8/include/v8-array-buffer.h"
+#include "v8/include/v8-context.h"
+#include "v8/include/v8-function.h"
+#include "v8/include/v8-microtask-queue.h"
+
+namespace electron::api {
+
+// The reader sets |reader_waiting| when it runs out of data, and the writer
+// sets |writer_waiting| when it runs out of space. Whoever moves the other
+// position next clears the flag and rings the doorbell. Both sides re-check
+// after setting their flag, so that a wakeup can't be lost between the check
+// and the flag.
+struct SharedRingBuffer::RingControl {
+  alignas(64) std::atomic<uint64_t> write_position{0U};
+  alignas(64) std::atomic<uint64_t> read_position{0U};
+  alignas(64) std::atomic<uint32_t> reader_waiting{0U};
+  alignas(64) std::atomic<uint32_t> writer_waiting{0U};
+};
+
+namespace {
+
+// The rings are shared between processes, so their atomics must not rely on
+// a lock that lives in either one.
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+// Every record starts with its length.
+constexpr size_t kRecordHeaderSize = sizeof(uint32_t);
+
+// Copies |bytes| into |ring| at |position|, wrapping around its end.
+void CopyToRing(base::span<uint8_t> ring,
+                uint64_t position,
+                base::span<const uint8_t> bytes) {
+  const size_t offset = position & (ring.size() - 1U);
+  const size_t head = std::min(bytes.size(), ring.size() - offset);
+  ring.subspan(offset, head).copy_from(bytes.first(head));
+  ring.first(bytes.size() - head).copy_from(bytes.subspan(head));
+}
+
+// Copies from |ring| at |position| into |bytes|, wrapping around its end.
+void CopyFromRing(base::span<const uint8_t> ring,
+                  uint64_t position,
+                  base::span<uint8_t> bytes) {
+  const size_t offset = position & (ring.size() - 1U);
+  const size_t head = std::min(bytes.size(), ring.size() - offset);
+  bytes.first(head).copy_from(ring.subspan(offset, head));
+  bytes.subspan(head).copy_from(ring.first(bytes.size() - head));
+}
+
+std::optional<base::span<const uint8_t>> GetBytes(v8::Local<v8::Value> value) {
+  if (value->IsArrayBufferView())
+    return util::as_byte_span(value.As<v8::ArrayBufferView>());
+  if (value->IsArrayBuffer()) {
+    auto buffer = value.As<v8::ArrayBuffer>();
+    return UNSAFE_BUFFERS(base::span(
+        static_cast<const uint8_t*>(buffer->Data()), buffer->ByteLength()));
+  }
+  return std::nullopt;
+}
+
+}  // namespace
+
+gin::DeprecatedWrapperInfo SharedRingBuffer::kWrapperInfo = {
+    gin::kEmbedderNativeGin};
+
+// static
+size_t SharedRingBuffer::GetRegionSize(size_t capacity) {
+  return 2U * (sizeof(RingControl) + capacity);
+}
+
+// static
+std::optional<SharedRingBuffer::EndpointPair>
+SharedRingBuffer::CreateEndpoints(size_t capacity) {
+  DCHECK(std::has_single_bit(capacity));
+  DCHECK_GE(capacity, kMinCapacity);
+  DCHECK_LE(capacity, kMaxCapacity);
+
+  auto region =
+      base::UnsafeSharedMemoryRegion::Create(GetRegionSize(capacity));
+  if (!region.IsValid())
+    return std::nullopt;
+
+  base::WritableSharedMemoryMapping mapping = region.Map();
+  if (!mapping.IsValid())
+    return std::nullopt;
+
+  // Neither ring has been read from yet, so the first write to each of them
+  // has to ring the doorbell.
+  auto* controls = static_cast<uint8_t*>(mapping.memory());
+  for (size_t i = 0U; i < 2U; ++i) {
+    auto* control =
+        new (UNSAFE_BUFFERS(controls + i * sizeof(RingControl))) RingControl;
+    control->reader_waiting.store(1U);
+  }
+
+  base::UnsafeSharedMemoryRegion duplicate = region.Duplicate();
+  if (!duplicate.IsValid())
+    return std::nullopt;
+
+  mojo::PendingRemote<mojom::SharedRingBufferPeer> first_peer;
+  auto second_receiver = first_peer.InitWithNewPipeAndPassReceiver();
+  mojo::PendingRemote<mojom::SharedRingBufferPeer> second_peer;
+  auto first_receiver = second_peer.InitWithNewPipeAndPassReceiver();
+
+  return EndpointPair{
+      mojom::SharedRingBufferEndpoint::New(std::move(duplicate), true,
+                                           std::move(first_peer),
+                                           std::move(first_receiver)),
+      mojom::SharedRingBufferEndpoint::New(std::move(region), false,
+                                           std::move(second_peer),
+                                           std::move(second_receiver))};
+}
+
+// static
+gin_helper::Handle<SharedRingBuffer> SharedRingBuffer::Create(
+    v8::Isolate* isolate,
+    mojom::SharedRingBufferEndpointPtr endpoint) {
+  if (!endpoint || !endpoint->region.IsValid() || !endpoint->peer ||
+      !endpoint->receiver) {
+    return {};
+  }
+
+  // The other side picks the size, so it has to be checked before the
+  // region is used.
+  const size_t size = endpoint->region.GetSize();
+  if (size <= GetRegionSize(0U))
+    return {};
+  const size_t capacity = (size - GetRegionSize(0U)) / 2U;
+  if (!std::has_single_bit(capacity) || capacity < kMinCapacity ||
+      capacity > kMaxCapacity || GetRegionSize(capacity) != size) {
+    return {};
+  }
+
+  base::WritableSharedMemoryMapping mapping = endpoint->region.Map();
+  if (!mapping.IsValid())
+    return {};
+
+  auto handle = gin_helper::CreateHandle(
+      isolate, new SharedRingBuffer(
+                   isolate, std::move(mapping), capacity,
+                   endpoint->writes_first_ring, std::move(endpoint->peer),
+                   std::move(endpoint->receiver)));
+  handle->Pin();
+  return handle;
+}
+
+SharedRingBuffer::SharedRingBuffer(
+    v8::Isolate* isolate,
+    base::WritableSharedMemoryMapping mapping,
+    size_t capacity,
+    bool writes_first_ring,
+    mojo::PendingRemote<mojom::SharedRingBufferPeer> peer,
+    mojo::PendingReceiver<mojom::SharedRingBufferPeer> receiver)
+    : isolate_{isolate},
+      capacity_{capacity},
+      writes_first_ring_{writes_first_ring},
+      mapping_{std::move(mapping)},
+      peer_{std::move(peer)} {
+  receiver_.Bind(std::move(receiver));
+  // The receiver and remote are owned by |this|, so their handlers can't
+  // outlive it.
+  receiver_.set_disconnect_handler(
+      base::BindOnce(&SharedRingBuffer::Close, base::Unretained(this)));
+  peer_.set_disconnect_handler(
+      base::BindOnce(&SharedRingBuffer::Close, base::Unretained(this)));
+}
+
+SharedRingBuffer::~SharedRingBuffer() = default;
+
+SharedRingBuffer::RingControl& SharedRingBuffer::GetControl(bool first_ring) {
+  DCHECK(IsOpen());
+  auto* controls = static_cast<uint8_t*>(mapping_.memory());
+  return *reinterpret_cast<RingControl*>(
+      UNSAFE_BUFFERS(controls + (first_ring ? 0U : sizeof(RingControl))));
+}
+
+base::span<uint8_t> SharedRingBuffer::GetData(bool first_ring) {
+  DCHECK(IsOpen());
+  return mapping_.GetMemoryAsSpan<uint8_t>().subspan(
+      GetRegionSize(0U) + (first_ring ? 0U : capacity_),
+      capacity_);
+}
+
+std::optional<size_t> SharedRingBuffer::GetFreeSpace(
+    uint64_t read_position) const {
+  const uint64_t used = write_position_ - read_position;
+  if (used > capacity_)
+    return std::nullopt;
+  return capacity_ - used;
+}
+
+bool SharedRingBuffer::Write(gin::Arguments* args) {
+  gin_helper::ErrorThrower thrower(args->isolate());
+
+  v8::Local<v8::Value> value;
+  std::optional<base::span<const uint8_t>> bytes;
+  if (args->GetNext(&value))
+    bytes = GetBytes(value);
+  if (!bytes) {
+    thrower.ThrowTypeError("data must be an ArrayBuffer or an ArrayBufferView");
+    return false;
+  }
+
+  if (!IsOpen()) {
+    thrower.ThrowError("SharedRingBuffer is closed");
+    return false;
+  }
+
+  const size_t record_size = kRecordHeaderSize + bytes->size();
+  if (record_size > capacity_) {
+    thrower.ThrowRangeError("data is larger than the ring buffer");
+    return false;
+  }
+
+  RingControl& control = GetControl(writes_first_ring_);
+  std::optional<size_t> free_space =
+      GetFreeSpace(control.read_position.load(std::memory_order_acquire));
+  if (free_space && *free_space < record_size) {
+    control.writer_waiting.store(1U);
+    free_space = GetFreeSpace(control.read_position.load());
+    if (free_space && *free_space < record_size)
+      return false;
+    control.writer_waiting.store(0U, std::memory_order_relaxed);
+  }
+  if (!free_space) {
+    // The other side moved its position somewhere it can't be.
+    Close();
+    return false;
+  }
+
+  const auto length = static_cast<uint32_t>(bytes->size());
+  base::span<uint8_t> ring = GetData(writes_first_ring_);
+  CopyToRing(ring, write_position_, base::byte_span_from_ref(length));
+  CopyToRing(ring, write_position_ + kRecordHeaderSize, *bytes);
+  write_position_ += record_size;
+  control.write_position.store(write_position_);
+
+  if (control.reader_waiting.exchange(0U))
+    peer_->OnDataAvailable();
+  return true;
+}
+
+v8::Local<v8::Value> SharedRingBuffer::Read(v8::Isolate* isolate) {
+  if (!IsOpen())
+    return v8::Null(isolate);
+
+  RingControl& control = GetControl(!writes_first_ring_);
+  uint64_t write_position =
+      control.write_position.load(std::memory_order_acquire);
+  if (write_position == read_position_) {
+    control.reader_waiting.store(1U);
+    write_position = control.write_position.load();
+    if (write_position == read_position_)
+      return v8::Null(isolate);
+    control.reader_waiting.store(0U, std::memory_order_relaxed);
+  }
+
+  // Only whole records are published, so anything shorter than a record
+  // header means the other side wrote somewhere it shouldn't have.
+  const uint64_t available = write_position - read_position_;
+  if (available < kRecordHeaderSize || available > capacity_) {
+    Close();
+    return v8::Null(isolate);
+  }
+
+  base::span<const uint8_t> ring = GetData(!writes_first_ring_);
+  uint32_t length = 0U;
+  CopyFromRing(ring, read_position_, base::byte_span_from_ref(length));
+  if (length > available - kRecordHeaderSize) {
+    Close();
+    return v8::Null(isolate);
+  }
+
+  auto buffer = v8::ArrayBuffer::New(isolate, length);
+  if (length > 0U) {
+    CopyFromRing(ring, read_position_ + kRecordHeaderSize,
+                 UNSAFE_BUFFERS(base::span(
+                     static_cast<uint8_t*>(buffer->Data()), length)));
+  }
+  read_position_ += kRecordHeaderSize + length;
+  control.read_position.store(read_position_);
+
+  if (control.writer_waiting.exchange(0U))
+    peer_->OnSpaceAvailable();
+  return v8::Uint8Array::New(buffer, 0U, length);
+}
+
+void SharedRingBuffer::Close() {
+  if (!IsOpen())
+    return;
+
+  Disconnect();
+  Emit("close");
+  Unpin();
+}
+
+void SharedRingBuffer::Shutdown() {
+  Disconnect();
+  Unpin();
+}
+
+void SharedRingBuffer::Disconnect() {
+  receiver_.reset();
+  peer_.reset();
+  mapping_ = {};
+}
+
+void SharedRingBuffer::Pin() {
+  v8::HandleScope scope(isolate_);
+  v8::Local<v8::Object> self;
+  if (GetWrapper(isolate_).ToLocal(&self))
+    pinned_.Reset(isolate_, self);
+}
+
+void SharedRingBuffer::Unpin() {
+  pinned_.Reset();
+}
+
+void SharedRingBuffer::OnDataAvailable() {
+  Emit("readable");
+}
+
+void SharedRingBuffer::OnSpaceAvailable() {
+  Emit("writable");
+}
+
+void SharedRingBuffer::Emit(std::string_view name) {
+  v8::HandleScope scope(isolate_);
+  v8::Local<v8::Object> self;
+  if (!GetWrapper(isolate_).ToLocal(&self))
+    return;
+
+  v8::Local<v8::Context> context = self->GetCreationContextChecked(isolate_);
+  v8::Context::Scope context_scope(context);
+  if (node::Environment::GetCurrent(context)) {
+    gin_helper::EmitEvent(isolate_, self, name);
+    return;
+  }
+
+  // Sandboxed renderers don't have a node environment to call into.
+  v8::MicrotasksScope microtasks_scope(isolate_, context->GetMicrotaskQueue(),
+                                       v8::MicrotasksScope::kRunMicrotasks);
+  v8::Local<v8::Value> emit;
+  if (!self->Get(context, gin::StringToV8(isolate_, "emit")).ToLocal(&emit) ||
+      !emit->IsFunction()) {
+    return;
+  }
+  std::array<v8::Local<v8::Value>, 1U> argv = {
+      gin::StringToV8(isolate_, name)};
+  std::ignore =
+      emit.As<v8::Function>()->Call(context, self, argv.size(), argv.data());
+}
+
+gin::ObjectTemplateBuilder SharedRingBuffer::GetObjectTemplateBuilder(
+    v8::Isolate* isolate) {
+  return gin_helper::DeprecatedWrappable<
+             SharedRingBuffer>::GetObjectTemplateBuilder(isolate)
+      .SetMethod("write", &SharedRingBuffer::Write)
+      .SetMethod("read", &SharedRingBuffer::Read)
+      .SetMethod("close", &SharedRingBuffer::Close)
+      .SetProperty("capacity", &SharedRingBuffer::Capacity);
+}
+
+const char* SharedRingBuffer::GetTypeName() {
+  return "SharedRingBuffer";
+}
+
+void SharedRingBuffer::WillBeDestroyed() {
+  Unpin();
+  ClearWeak();
+}
+
+}  // namespace electron::api
@@ -0,0 +1,151 @@
+// Copyright (c) 2026 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_API_ELECTRON_API_SHARED_RING_BUFFER_H_
+#define ELECTRON_SHELL_COMMON_API_ELECTRON_API_SHARED_RING_BUFFER_H_
+
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#include "base/containers/span.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/shared_memory_mapping.h"
+#include "base/memory/weak_ptr.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "shell/common/api/api.mojom.h"
+#include "shell/common/gin_helper/cleaned_up_at_exit.h"
+#include "shell/common/gin_helper/wrappable.h"
+#include "v8/include/v8-persistent-handle.h"
+
+namespace gin {
+class Arguments;
+}  // namespace gin
+
+namespace gin_helper {
+template <typename T>
+class Handle;
+}  // namespace gin_helper
+
+namespace electron::api {
+
+// A channel between the main process and a renderer that passes bytes through
+// shared memory instead of serializing them into IPC messages.
+//
+// The shared region holds two single-producer, single-consumer rings, one for
+// each direction. Mojo is only used to wake up a side that is waiting for data
+// to read or for space to write.
+//
+// The wrapper is kept alive while the channel is open, since it is usually
+// only referenced by its own event listeners.
+class SharedRingBuffer final
+    : public gin_helper::DeprecatedWrappable<SharedRingBuffer>,
+      public gin_helper::CleanedUpAtExit,
+      private mojom::SharedRingBufferPeer {
+ public:
+  // Bounds of the number of bytes each ring can hold.
+  static constexpr size_t kMinCapacity = 4U * 1024U;
+  static constexpr size_t kMaxCapacity = 64U * 1024U * 1024U;
+
+  using EndpointPair = std::pair<mojom::SharedRingBufferEndpointPtr,
+                                 mojom::SharedRingBufferEndpointPtr>;
+
+  // Creates both endpoints of a channel whose rings each hold |capacity|
+  // bytes. |capacity| must be a power of two between kMinCapacity and
+  // kMaxCapacity. Returns std::nullopt if the shared memory can't be
+  // allocated.
+  static std::optional<EndpointPair> CreateEndpoints(size_t capacity);
+
+  // Returns an empty handle if |endpoint| doesn't describe a valid channel.
+  static gin_helper::Handle<SharedRingBuffer> Create(
+      v8::Isolate* isolate,
+      mojom::SharedRingBufferEndpointPtr endpoint);
+
+  // gin_helper::Wrappable
+  static gin::DeprecatedWrapperInfo kWrapperInfo;
+  gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
+      v8::Isolate* isolate) override;
+  const char* GetTypeName() override;
+
+  // gin_helper::CleanedUpAtExit
+  void WillBeDestroyed() override;
+
+  // Closes the channel without emitting 'close', for when the context that
+  // the wrapper lives in is going away.
+  void Shutdown();
+
+  base::WeakPtr<SharedRingBuffer> GetWeakPtr() {
+    return weak_factory_.GetWeakPtr();
+  }
+
+  // disable copy
+  SharedRingBuffer(const SharedRingBuffer&) = delete;
+  SharedRingBuffer& operator=(const SharedRingBuffer&) = delete;
+
+ private:
+  // Control block at the start of each ring. Defined in the .cc file.
+  struct RingControl;
+
+  SharedRingBuffer(v8::Isolate* isolate,
+                   base::WritableSharedMemoryMapping mapping,
+                   size_t capacity,
+                   bool writes_first_ring,
+                   mojo::PendingRemote<mojom::SharedRingBufferPeer> peer,
+                   mojo::PendingReceiver<mojom::SharedRingBufferPeer> receiver);
+  ~SharedRingBuffer() override;
+
+  // JS API
+  bool Write(gin::Arguments* args);
+  v8::Local<v8::Value> Read(v8::Isolate* isolate);
+  void Close();
+  size_t Capacity() const { return capacity_; }
+
+  // mojom::SharedRingBufferPeer
+  void OnDataAvailable() override;
+  void OnSpaceAvailable() override;
+
+  // Size of a region holding two rings of |capacity| bytes each.
+  static size_t GetRegionSize(size_t capacity);
+
+  [[nodiscard]] bool IsOpen() const { return mapping_.IsValid(); }
+
+  // Returns the number of bytes that can be written to the outgoing ring, or
+  // std::nullopt if |read_position| can't be right.
+  std::optional<size_t> GetFreeSpace(uint64_t read_position) const;
+
+  RingControl& GetControl(bool first_ring);
+  base::span<uint8_t> GetData(bool first_ring);
+
+  void Emit(std::string_view name);
+
+  // Releases the shared memory and the Mojo endpoints.
+  void Disconnect();
+
+  void Pin();
+  void Unpin();
+
+  const raw_ptr<v8::Isolate> isolate_;
+  const size_t capacity_;
+  const bool writes_first_ring_;
+
+  base::WritableSharedMemoryMapping mapping_;
+
+  // Positions are byte counts that only grow, so that a full ring can be told
+  // apart from an empty one. Each side keeps its own position here and never
+  // trusts the copy in shared memory, which the other side can write to.
+  uint64_t write_position_ = 0U;
+  uint64_t read_position_ = 0U;
+
+  mojo::Remote<mojom::SharedRingBufferPeer> peer_;
+  mojo::Receiver<mojom::SharedRingBufferPeer> receiver_{this};
+
+  v8::Global<v8::Value> pinned_;
+
+  base::WeakPtrFactory<SharedRingBuffer> weak_factory_{this};
+};
+
+}  // namespace electron::api
+
+#endif  // ELECTRON_SHELL_COMMON_API_ELECTRON_API_SHARED_RING_BUFFER_H_
@@ -33,8 +33,10 @@
 
 namespace electron {
 
-ElectronBindings::ElectronBindings(uv_loop_t* loop) {
-  uv_async_init(loop, call_next_tick_async_.get(), OnCallNextTick);
+ElectronBindings::ElectronBindings(NodeBindings* node_bindings)
+    : node_bindings_(node_bindings) {
+  uv_async_init(node_bindings->uv_loop(), call_next_tick_async_.get(),
+                OnCallNextTick);
   call_next_tick_async_.get()->data = this;
   metrics_ = base::ProcessMetrics::CreateCurrentProcessMetrics();
 }
@@ -83,6 +85,9 @@ void ElectronBindings::BindTo(v8::Isolate* isolate,
   dict.SetMethod("activateUvLoop",
                  base::BindRepeating(&ElectronBindings::ActivateUVLoop,
                                      base::Unretained(this)));
+  dict.SetMethod("getUvRunMetrics",
+                 base::BindRepeating(&ElectronBindings::GetUvRunMetrics,
+                                     base::Unretained(this)));
 }
 
 void ElectronBindings::EnvironmentDestroyed(node::Environment* env) {
@@ -98,6 +103,18 @@ void ElectronBindings::ActivateUVLoop(v8::Isolate* isolate) {
   uv_async_send(call_next_tick_async_.get());
 }
 
+v8::Local<v8::Value> ElectronBindings::GetUvRunMetrics(
+    v8::Isolate* isolate) const {
+  const NodeBindings::UvRunMetrics& metrics = node_bindings_->uv_run_metrics();
+  auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+  dict.Set("wakeups", static_cast<double>(metrics.wakeups));
+  dict.Set("iterations", static_cast<double>(metrics.iterations));
+  dict.Set("wakeupsOverBudget",
+           static_cast<double>(metrics.wakeups_over_budget));
+  dict.Set("runTime", metrics.run_time.InMillisecondsF());
+  return dict.GetHandle();
+}
+
 // static
 void ElectronBindings::OnCallNextTick(uv_async_t* handle) {
   auto* self = static_cast<ElectronBindings*>(handle->data);
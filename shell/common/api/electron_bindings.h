@@ -8,6 +8,7 @@
 #include <list>
 #include <memory>
 
+#include "base/memory/raw_ptr.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/process/process_metrics.h"
 #include "services/resource_coordinator/public/mojom/memory_instrumentation/memory_instrumentation.mojom-forward.h"
@@ -36,7 +37,7 @@ namespace electron {
 
 class ElectronBindings {
  public:
-  explicit ElectronBindings(uv_loop_t* loop);
+  explicit ElectronBindings(NodeBindings* node_bindings);
   virtual ~ElectronBindings();
 
   // disable copy
@@ -76,9 +77,11 @@ class ElectronBindings {
                                const base::FilePath& file_path);
 
   void ActivateUVLoop(v8::Isolate* isolate);
+  v8::Local<v8::Value> GetUvRunMetrics(v8::Isolate* isolate) const;
 
   static void OnCallNextTick(uv_async_t* handle);
 
+  const raw_ptr<NodeBindings> node_bindings_;
   UvHandle<uv_async_t> call_next_tick_async_;
   std::list<node::Environment*> pending_next_ticks_;
   std::unique_ptr<base::ProcessMetrics> metrics_;
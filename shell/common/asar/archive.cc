@@ -4,6 +4,7 @@
 
 #include "shell/common/asar/archive.h"
 
+#include <algorithm>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -11,14 +12,17 @@
 
 #include "base/check.h"
 #include "base/containers/span.h"
+#include "base/environment.h"
 #include "base/files/file.h"
 #include "base/files/file_util.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/json/json_reader.h"
 #include "base/logging.h"
 #include "base/pickle.h"
-#include "base/strings/string_number_conversions.h"
 #include "base/values.h"
+#include "crypto/hash.h"
 #include "electron/fuses.h"
+#include "shell/common/asar/archive_trace.h"
 #include "shell/common/asar/asar_util.h"
 #include "shell/common/asar/scoped_temporary_file.h"
 #include "shell/common/thread_restrictions.h"
@@ -31,128 +35,21 @@ namespace asar {
 
 namespace {
 
+// When set, archives whose index file is missing or stale write a fresh one
+// next to the archive after parsing the JSON header.
+const char kGenerateIndexEnvVar[] = "ELECTRON_GENERATE_ASAR_INDEX";
+
+// Returns |path| in the form used by ArchiveIndex. On POSIX this is a view of
+// the path itself; elsewhere the path is converted into |storage|.
+std::string_view ToIndexPath(const base::FilePath& path,
+                             std::string& storage) {
 #if BUILDFLAG(IS_WIN)
-const char kSeparators[] = "\\/";
+  storage = path.AsUTF8Unsafe();
+  std::ranges::replace(storage, '\\', '/');
+  return storage;
 #else
-const char kSeparators[] = "/";
+  return path.value();
 #endif
-
-const base::Value::Dict* GetNodeFromPath(std::string path,
-                                         const base::Value::Dict& root);
-
-// Gets the "files" from "dir".
-const base::Value::Dict* GetFilesNode(const base::Value::Dict& root,
-                                      const base::Value::Dict& dir) {
-  // Test for symbol linked directory.
-  const std::string* link = dir.FindString("link");
-  if (link != nullptr) {
-    const base::Value::Dict* linked_node = GetNodeFromPath(*link, root);
-    if (!linked_node)
-      return nullptr;
-    return linked_node->FindDict("files");
-  }
-
-  return dir.FindDict("files");
-}
-
-// Gets sub-file "name" from "dir".
-const base::Value::Dict* GetChildNode(const base::Value::Dict& root,
-                                      const std::string& name,
-                                      const base::Value::Dict& dir) {
-  if (name.empty())
-    return &root;
-
-  const base::Value::Dict* files = GetFilesNode(root, dir);
-  return files ? files->FindDict(name) : nullptr;
-}
-
-// Gets the node of "path" from "root".
-const base::Value::Dict* GetNodeFromPath(std::string path,
-                                         const base::Value::Dict& root) {
-  if (path.empty())
-    return &root;
-
-  const base::Value::Dict* dir = &root;
-  for (size_t delimiter_position = path.find_first_of(kSeparators);
-       delimiter_position != std::string::npos;
-       delimiter_position = path.find_first_of(kSeparators)) {
-    const base::Value::Dict* child =
-        GetChildNode(root, path.substr(0, delimiter_position), *dir);
-    if (!child)
-      return nullptr;
-
-    dir = child;
-    path.erase(0, delimiter_position + 1);
-  }
-
-  return GetChildNode(root, path, *dir);
-}
-
-bool FillFileInfoWithNode(Archive::FileInfo* info,
-                          uint32_t header_size,
-                          bool load_integrity,
-                          const base::Value::Dict* node) {
-  if (std::optional<int> size = node->FindInt("size")) {
-    info->size = static_cast<uint32_t>(*size);
-  } else {
-    return false;
-  }
-
-  if (std::optional<bool> unpacked = node->FindBool("unpacked")) {
-    info->unpacked = *unpacked;
-    if (info->unpacked) {
-      return true;
-    }
-  }
-
-  const std::string* offset = node->FindString("offset");
-  if (offset &&
-      base::StringToUint64(std::string_view{*offset}, &info->offset)) {
-    info->offset += header_size;
-  } else {
-    return false;
-  }
-
-  if (std::optional<bool> executable = node->FindBool("executable")) {
-    info->executable = *executable;
-  }
-
-#if BUILDFLAG(IS_MAC) || BUILDFLAG(IS_WIN)
-  if (load_integrity &&
-      electron::fuses::IsEmbeddedAsarIntegrityValidationEnabled()) {
-    if (const base::Value::Dict* integrity = node->FindDict("integrity")) {
-      const std::string* algorithm = integrity->FindString("algorithm");
-      const std::string* hash = integrity->FindString("hash");
-      std::optional<int> block_size = integrity->FindInt("blockSize");
-      const base::Value::List* blocks = integrity->FindList("blocks");
-
-      if (algorithm && hash && block_size && block_size > 0 && blocks) {
-        IntegrityPayload integrity_payload;
-        integrity_payload.hash = *hash;
-        integrity_payload.block_size =
-            static_cast<uint32_t>(block_size.value());
-        for (auto& value : *blocks) {
-          if (const std::string* block = value.GetIfString()) {
-            integrity_payload.blocks.push_back(*block);
-          } else {
-            LOG(FATAL)
-                << "Invalid block integrity value for file in ASAR archive";
-          }
-        }
-        if (*algorithm == "SHA256") {
-          integrity_payload.algorithm = HashAlgorithm::kSHA256;
-          info->integrity = std::move(integrity_payload);
-        }
-      }
-    }
-
-    if (!info->integrity.has_value()) {
-      LOG(FATAL) << "Failed to read integrity for file in ASAR archive";
-    }
-  }
-#endif
-
-  return true;
 }
 
 }  // namespace
@@ -255,6 +152,21 @@ bool Archive::Init() {
   }
 #endif
 
+  header_size_ = 8 + size;
+  StartTrace();
+
+  // Index files are not covered by the embedded integrity hashes, so they are
+  // only trusted when the archive itself isn't being validated.
+  std::optional<ArchiveIndex::Source> index_source;
+  if (!header_validated_) {
+    index_source = GetIndexSource(header);
+    if (index_source) {
+      index_ = ArchiveIndex::Load(IndexFilePath(), *index_source);
+      if (index_)
+        return true;
+    }
+  }
+
   std::optional<base::Value> value =
       base::JSONReader::Read(header, base::JSON_PARSE_CHROMIUM_EXTENSIONS);
   if (!value || !value->is_dict()) {
@@ -262,11 +174,57 @@ bool Archive::Init() {
     return false;
   }
 
-  header_size_ = 8 + size;
-  header_ = std::move(*value).TakeDict();
+  bool load_integrity = false;
+#if BUILDFLAG(IS_MAC) || BUILDFLAG(IS_WIN)
+  load_integrity = header_validated_ &&
+                   electron::fuses::IsEmbeddedAsarIntegrityValidationEnabled();
+#endif
+  // Only the flattened index is kept; the parsed JSON is released here.
+  index_ = ArchiveIndex::Build(value->GetDict(), load_integrity);
+
+  if (index_source &&
+      base::Environment::Create()->HasVar(kGenerateIndexEnvVar)) {
+    if (!index_->Write(IndexFilePath(), *index_source))
+      LOG(WARNING) << "Failed to write asar index for " << path_.value();
+  }
+
   return true;
 }
 
+void Archive::StartTrace() {
+  electron::ScopedAllowBlockingForElectron allow_blocking;
+  base::File::Info file_info;
+  if (!file_.GetInfo(&file_info))
+    return;
+
+  trace_recorder_ = ArchiveTraceRecorder::MaybeCreate(
+      GetArchiveTraceRecordPath(path_), file_info);
+  if (!trace_recorder_)
+    PrefetchArchiveTrace(file_.Duplicate(), file_info, path_);
+}
+
+base::FilePath Archive::IndexFilePath() const {
+  return path_.AddExtension(FILE_PATH_LITERAL("index"));
+}
+
+std::optional<ArchiveIndex::Source> Archive::GetIndexSource(
+    std::string_view header) const {
+  base::File::Info file_info;
+  {
+    electron::ScopedAllowBlockingForElectron allow_blocking;
+    if (!file_.GetInfo(&file_info))
+      return std::nullopt;
+  }
+
+  ArchiveIndex::Source source;
+  source.archive_size = static_cast<uint64_t>(file_info.size);
+  source.archive_mtime =
+      file_info.last_modified.ToDeltaSinceWindowsEpoch().InMicroseconds();
+  source.header_size = header_size_;
+  source.header_hash = crypto::hash::Sha256(base::as_byte_span(header));
+  return source;
+}
+
 #if !BUILDFLAG(IS_MAC) && !BUILDFLAG(IS_WIN)
 std::optional<IntegrityPayload> Archive::HeaderIntegrity() const {
   return std::nullopt;
@@ -277,76 +235,127 @@ std::optional<base::FilePath> Archive::RelativePath() const {
 }
 #endif
 
-bool Archive::GetFileInfo(const base::FilePath& path, FileInfo* info) const {
-  if (!header_)
+uint32_t Archive::FindResolved(const base::FilePath& path) const {
+  std::string storage;
+  uint32_t index = index_->Find(ToIndexPath(path, storage));
+  for (int depth = 0; index != ArchiveIndex::kNoEntry; ++depth) {
+    const ArchiveIndex::Entry& entry = index_->entry(index);
+    if (entry.type != ArchiveIndex::EntryType::kLink)
+      return index;
+    if (depth == ArchiveIndex::kMaxLinkDepth)
+      break;
+    index = index_->Find(index_->GetString(entry.link));
+  }
+
+  return ArchiveIndex::kNoEntry;
+}
+
+bool Archive::FillFileInfo(const ArchiveIndex::Entry& entry,
+                           FileInfo* info) const {
+  if (!(entry.flags & ArchiveIndex::kHasFileInfo))
     return false;
 
-  const base::Value::Dict* node =
-      GetNodeFromPath(path.AsUTF8Unsafe(), *header_);
-  if (!node)
+  info->size = entry.size;
+  info->unpacked = entry.flags & ArchiveIndex::kUnpacked;
+  if (info->unpacked)
+    return true;
+
+  info->offset = entry.offset + header_size_;
+  info->executable = entry.flags & ArchiveIndex::kExecutable;
+
+#if BUILDFLAG(IS_MAC) || BUILDFLAG(IS_WIN)
+  if (header_validated_ &&
+      electron::fuses::IsEmbeddedAsarIntegrityValidationEnabled()) {
+    if (entry.flags & ArchiveIndex::kInvalidIntegrity)
+      LOG(FATAL) << "Invalid block integrity value for file in ASAR archive";
+
+    if (entry.integrity == ArchiveIndex::kNoIntegrity)
+      LOG(FATAL) << "Failed to read integrity for file in ASAR archive";
+
+    const ArchiveIndex::Integrity& integrity =
+        index_->integrity(entry.integrity);
+    IntegrityPayload integrity_payload;
+    integrity_payload.algorithm = HashAlgorithm::kSHA256;
+    integrity_payload.hash = index_->GetString(integrity.hash);
+    integrity_payload.block_size = integrity.block_size;
+    integrity_payload.blocks.reserve(integrity.block_count);
+    for (const ArchiveIndex::StringRef& block : index_->blocks(integrity))
+      integrity_payload.blocks.emplace_back(index_->GetString(block));
+    info->integrity = std::move(integrity_payload);
+  }
+#endif
+
+  return true;
+}
+
+bool Archive::GetFileInfo(const base::FilePath& path, FileInfo* info) const {
+  if (!index_)
     return false;
 
-  const std::string* link = node->FindString("link");
-  if (link)
-    return GetFileInfo(base::FilePath::FromUTF8Unsafe(*link), info);
+  const uint32_t index = FindResolved(path);
+  if (index == ArchiveIndex::kNoEntry)
+    return false;
 
-  return FillFileInfoWithNode(info, header_size_, header_validated_, node);
+  return FillFileInfo(index_->entry(index), info);
 }
 
 bool Archive::Stat(const base::FilePath& path, Stats* stats) const {
-  if (!header_)
+  if (!index_)
     return false;
 
-  const base::Value::Dict* node =
-      GetNodeFromPath(path.AsUTF8Unsafe(), *header_);
-  if (!node)
+  std::string storage;
+  const uint32_t index = index_->Find(ToIndexPath(path, storage));
+  if (index == ArchiveIndex::kNoEntry)
     return false;
 
-  if (node->Find("link")) {
-    stats->type = FileType::kLink;
-    return true;
-  }
-
-  if (node->Find("files")) {
-    stats->type = FileType::kDirectory;
-    return true;
+  const ArchiveIndex::Entry& entry = index_->entry(index);
+  switch (entry.type) {
+    case ArchiveIndex::EntryType::kLink:
+      stats->type = FileType::kLink;
+      return true;
+    case ArchiveIndex::EntryType::kDirectory:
+      stats->type = FileType::kDirectory;
+      return true;
+    case ArchiveIndex::EntryType::kFile:
+      return FillFileInfo(entry, stats);
   }
-
-  return FillFileInfoWithNode(stats, header_size_, header_validated_, node);
 }
 
 bool Archive::Readdir(const base::FilePath& path,
                       std::vector<base::FilePath>* files) const {
-  if (!header_)
+  if (!index_)
     return false;
 
-  const base::Value::Dict* node =
-      GetNodeFromPath(path.AsUTF8Unsafe(), *header_);
-  if (!node)
+  std::string storage;
+  uint32_t index = index_->Find(ToIndexPath(path, storage));
+  if (index == ArchiveIndex::kNoEntry)
     return false;
 
-  const base::Value::Dict* files_node = GetFilesNode(*header_, *node);
-  if (!files_node)
+  index = index_->ResolveDirectory(index);
+  if (index == ArchiveIndex::kNoEntry)
     return false;
 
-  for (const auto iter : *files_node)
-    files->push_back(base::FilePath::FromUTF8Unsafe(iter.first));
+  const auto children = index_->children(index_->entry(index));
+  files->reserve(files->size() + children.size());
+  for (const ArchiveIndex::Entry& child : children)
+    files->push_back(
+        base::FilePath::FromUTF8Unsafe(index_->GetString(child.name)));
   return true;
 }
 
 bool Archive::Realpath(const base::FilePath& path,
                        base::FilePath* realpath) const {
-  if (!header_)
+  if (!index_)
     return false;
 
-  const base::Value::Dict* node =
-      GetNodeFromPath(path.AsUTF8Unsafe(), *header_);
-  if (!node)
+  std::string storage;
+  const uint32_t index = index_->Find(ToIndexPath(path, storage));
+  if (index == ArchiveIndex::kNoEntry)
     return false;
 
-  const std::string* link = node->FindString("link");
-  if (link) {
-    *realpath = base::FilePath::FromUTF8Unsafe(*link);
+  const ArchiveIndex::Entry& entry = index_->entry(index);
+  if (entry.type == ArchiveIndex::EntryType::kLink) {
+    *realpath = base::FilePath::FromUTF8Unsafe(index_->GetString(entry.link));
     return true;
   }
 
@@ -355,7 +364,7 @@ bool Archive::Realpath(const base::FilePath& path,
 }
 
 bool Archive::CopyFileOut(const base::FilePath& path, base::FilePath* out) {
-  if (!header_)
+  if (!index_)
     return false;
 
   base::AutoLock auto_lock(external_files_lock_);
@@ -377,9 +386,14 @@ bool Archive::CopyFileOut(const base::FilePath& path, base::FilePath* out) {
 
   auto temp_file = std::make_unique<ScopedTemporaryFile>();
   base::FilePath::StringType ext = path.Extension();
-  if (!temp_file->InitFromFile(&file_, ext, info.offset, info.size,
-                               info.integrity))
+  if (const std::optional<base::span<const uint8_t>> contents =
+          GetFileContents(info)) {
+    if (!temp_file->InitFromBytes(ext, *contents))
+      return false;
+  } else if (!temp_file->InitFromFile(&file_, ext, info.offset, info.size,
+                                      info.integrity)) {
     return false;
+  }
 
 #if BUILDFLAG(IS_POSIX)
   if (info.executable) {
@@ -393,6 +407,97 @@ bool Archive::CopyFileOut(const base::FilePath& path, base::FilePath* out) {
   return true;
 }
 
+std::optional<base::span<const uint8_t>> Archive::GetFileContents(
+    const FileInfo& info) {
+  return GetFileContents(info, 0U, info.size);
+}
+
+std::optional<base::span<const uint8_t>> Archive::GetFileContents(
+    const FileInfo& info,
+    uint64_t offset,
+    uint64_t length) {
+  if (info.unpacked || offset > info.size || length > info.size - offset)
+    return std::nullopt;
+
+  base::span<const uint8_t> bytes;
+  {
+    base::AutoLock auto_lock(mapped_file_lock_);
+    if (!mapped_file_ && !mapping_failed_) {
+      electron::ScopedAllowBlockingForElectron allow_blocking;
+      auto mapped_file = std::make_unique<base::MemoryMappedFile>();
+      if (mapped_file->Initialize(file_.Duplicate())) {
+        mapped_file_ = std::move(mapped_file);
+      } else {
+        LOG(ERROR) << "Failed to map " << path_.value();
+        mapping_failed_ = true;
+      }
+    }
+    if (!mapped_file_)
+      return std::nullopt;
+    bytes = mapped_file_->bytes();
+  }
+
+  if (info.offset > bytes.size() || info.size > bytes.size() - info.offset)
+    return std::nullopt;
+
+  const base::span<const uint8_t> contents =
+      bytes.subspan(info.offset, info.size);
+  if (info.integrity)
+    ValidateBlocksOrDie(info, contents, offset, offset + length);
+  if (trace_recorder_)
+    trace_recorder_->RecordRead(info.offset + offset, length);
+
+  return contents.subspan(offset, length);
+}
+
+void Archive::ValidateBlocksOrDie(const FileInfo& info,
+                                  base::span<const uint8_t> contents,
+                                  uint64_t begin,
+                                  uint64_t end) {
+  const IntegrityPayload& integrity = *info.integrity;
+
+  // Empty files carry the hash of no data as their only block.
+  if (contents.empty()) {
+    ValidateIntegrityOrDie(contents, integrity);
+    return;
+  }
+  if (begin >= end)
+    return;
+
+  const uint64_t block_size = integrity.block_size;
+  const uint64_t first_block = begin / block_size;
+  const uint64_t last_block = (end - 1) / block_size;
+  if (last_block >= integrity.blocks.size())
+    LOG(FATAL) << "Missing integrity block for file in ASAR archive";
+
+  // Blocks are remembered by their offset in the archive.
+  std::vector<uint64_t> pending;
+  {
+    base::AutoLock auto_lock(validated_blocks_lock_);
+    for (uint64_t i = first_block; i <= last_block; ++i) {
+      if (!validated_blocks_.contains(info.offset + i * block_size))
+        pending.push_back(i);
+    }
+  }
+  if (pending.empty())
+    return;
+
+  std::vector<IntegrityBlock> blocks;
+  blocks.reserve(pending.size());
+  for (uint64_t i : pending) {
+    const uint64_t block_offset = i * block_size;
+    blocks.push_back(
+        {contents.subspan(block_offset,
+                          std::min(block_size, contents.size() - block_offset)),
+         integrity.blocks[i]});
+  }
+  ValidateIntegrityBlocksOrDie(std::move(blocks));
+
+  base::AutoLock auto_lock(validated_blocks_lock_);
+  for (uint64_t i : pending)
+    validated_blocks_.insert(info.offset + i * block_size);
+}
+
 int Archive::GetUnsafeFD() const {
   return fd_;
 }
@@ -8,18 +8,26 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <uv.h>
 
+#include "base/containers/span.h"
 #include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "base/synchronization/lock.h"
-#include "base/values.h"
+#include "shell/common/asar/archive_index.h"
 #include "third_party/abseil-cpp/absl/container/flat_hash_map.h"
+#include "third_party/abseil-cpp/absl/container/flat_hash_set.h"
+
+namespace base {
+class MemoryMappedFile;
+}
 
 namespace asar {
 
+class ArchiveTraceRecorder;
 class ScopedTemporaryFile;
 
 enum class HashAlgorithm {
@@ -91,6 +99,18 @@ class Archive {
   // For unpacked file, this method will return its real path.
   bool CopyFileOut(const base::FilePath& path, base::FilePath* out);
 
+  // Returns the contents of a packed file as a view of the archive, which is
+  // memory-mapped on first use. The file's integrity is validated before it is
+  // returned. The view stays valid for the lifetime of the archive.
+  std::optional<base::span<const uint8_t>> GetFileContents(
+      const FileInfo& info);
+
+  // Same as above, but returns only |length| bytes starting at |offset| within
+  // the file. Only the integrity blocks overlapping that range are validated.
+  std::optional<base::span<const uint8_t>> GetFileContents(const FileInfo& info,
+                                                           uint64_t offset,
+                                                           uint64_t length);
+
   // Returns the file's fd.
   // Using this fd will not validate the integrity of any files
   // you read out of the ASAR manually.  Callers are responsible
@@ -100,13 +120,50 @@ class Archive {
   base::FilePath path() const { return path_; }
 
  private:
+  // Returns the index entry at |path| with links at the final component
+  // followed, or ArchiveIndex::kNoEntry.
+  uint32_t FindResolved(const base::FilePath& path) const;
+
+  bool FillFileInfo(const ArchiveIndex::Entry& entry, FileInfo* info) const;
+
+  // Validates the integrity blocks of |contents|, the whole packed file
+  // described by |info|, that overlap [begin, end). Blocks validated by an
+  // earlier call are skipped.
+  void ValidateBlocksOrDie(const FileInfo& info,
+                           base::span<const uint8_t> contents,
+                           uint64_t begin,
+                           uint64_t end);
+
+  // Starts recording the ranges read from the archive when requested, or
+  // otherwise replays an earlier recording as read-ahead hints.
+  void StartTrace();
+
+  // Path of the precompiled index kept next to the archive.
+  base::FilePath IndexFilePath() const;
+
+  // Describes the archive for validating its index file against.
+  std::optional<ArchiveIndex::Source> GetIndexSource(
+      std::string_view header) const;
+
   bool initialized_ = false;
   bool header_validated_ = false;
   const base::FilePath path_;
   base::File file_{base::File::FILE_OK};
   int fd_ = -1;
   uint32_t header_size_ = 0;
-  std::optional<base::Value::Dict> header_;
+  std::unique_ptr<ArchiveIndex> index_;
+
+  // Lazily created mapping of the whole archive.
+  base::Lock mapped_file_lock_;
+  std::unique_ptr<base::MemoryMappedFile> mapped_file_;
+  bool mapping_failed_ = false;
+
+  // Set while ELECTRON_RECORD_ASAR_TRACE is recording this archive.
+  std::unique_ptr<ArchiveTraceRecorder> trace_recorder_;
+
+  // Archive offsets of integrity blocks that have already been validated.
+  base::Lock validated_blocks_lock_;
+  absl::flat_hash_set<uint64_t> validated_blocks_;
 
   // Cached external temporary files.
   base::Lock external_files_lock_;
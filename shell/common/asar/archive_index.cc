@@ -0,0 +1,448 @@
+// Copyright (c) 2026 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/asar/archive_index.h"
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "base/compiler_specific.h"
+#include "base/containers/span.h"
+#include "base/files/file_path.h"
+#include "base/files/important_file_writer.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+#include "base/memory/raw_ptr.h"
+#include "base/numerics/checked_math.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_view_util.h"
+#include "build/build_config.h"
+#include "shell/common/thread_restrictions.h"
+
+namespace asar {
+
+namespace {
+
+#if BUILDFLAG(IS_WIN)
+const char kSeparators[] = "\\/";
+#else
+const char kSeparators[] = "/";
+#endif
+
+// "ASRI", read as a little-endian integer. A byte-swapped value means the
+// index was written on a machine with a different byte order.
+constexpr uint32_t kIndexFileMagic = 0x49525341;
+// Must be bumped whenever the layout of the file or of any table changes.
+constexpr uint32_t kIndexFileVersion = 3;
+
+// Leading block of an index file. It is followed by the entry table, the
+// sorted table and the string arena, each starting on an 8-byte boundary.
+struct IndexFileHeader {
+  uint32_t magic = kIndexFileMagic;
+  uint32_t version = kIndexFileVersion;
+  uint64_t archive_size = 0U;
+  int64_t archive_mtime = 0;
+  uint32_t header_size = 0U;
+  uint32_t entry_count = 0U;
+  uint32_t strings_size = 0U;
+  uint32_t reserved = 0U;
+  std::array<uint8_t, 32> header_hash = {};
+};
+
+static_assert(std::is_trivially_copyable_v<IndexFileHeader>);
+static_assert(std::is_trivially_copyable_v<ArchiveIndex::Entry>);
+static_assert(sizeof(IndexFileHeader) % 8 == 0);
+static_assert(sizeof(ArchiveIndex::Entry) % 8 == 0);
+static_assert(alignof(ArchiveIndex::Entry) <= 8);
+
+// Byte offsets of the tables that follow an IndexFileHeader.
+struct IndexFileLayout {
+  size_t entries_offset = sizeof(IndexFileHeader);
+  size_t sorted_offset = 0U;
+  size_t strings_offset = 0U;
+  size_t total_size = 0U;
+};
+
+std::optional<IndexFileLayout> GetIndexFileLayout(uint32_t entry_count,
+                                                  uint32_t strings_size) {
+  IndexFileLayout layout;
+  const base::CheckedNumeric<size_t> sorted_offset =
+      base::CheckedNumeric<size_t>(entry_count) * sizeof(ArchiveIndex::Entry) +
+      layout.entries_offset;
+  const base::CheckedNumeric<size_t> strings_offset =
+      (sorted_offset + base::CheckedNumeric<size_t>(entry_count) * 4 + 7) / 8 *
+      8;
+  const base::CheckedNumeric<size_t> total_size =
+      strings_offset + strings_size;
+  if (!sorted_offset.AssignIfValid(&layout.sorted_offset) ||
+      !strings_offset.AssignIfValid(&layout.strings_offset) ||
+      !total_size.AssignIfValid(&layout.total_size)) {
+    return std::nullopt;
+  }
+  return layout;
+}
+
+}  // namespace
+
+class ArchiveIndex::Builder {
+ public:
+  Builder(ArchiveIndex* index, bool load_integrity)
+      : index_{index}, load_integrity_{load_integrity} {}
+
+  // disable copy
+  Builder(const Builder&) = delete;
+  Builder& operator=(const Builder&) = delete;
+
+  void Build(const base::Value::Dict& root) {
+    index_->owned_entries_.emplace_back();
+    std::string path;
+    FillEntry(kRootEntry, root, path, 0U);
+
+    const auto& entries = index_->owned_entries_;
+    const std::string_view strings = index_->owned_strings_;
+    auto& sorted = index_->owned_sorted_;
+    sorted.resize(entries.size());
+    for (uint32_t i = 0; i < sorted.size(); ++i)
+      sorted[i] = i;
+    std::ranges::sort(sorted, {}, [&](uint32_t i) {
+      return strings.substr(entries[i].path.offset, entries[i].path.length);
+    });
+
+    index_->owned_entries_.shrink_to_fit();
+    index_->owned_strings_.shrink_to_fit();
+    index_->owned_integrity_.shrink_to_fit();
+    index_->owned_blocks_.shrink_to_fit();
+
+    index_->entries_ = index_->owned_entries_;
+    index_->sorted_ = index_->owned_sorted_;
+    index_->integrity_ = index_->owned_integrity_;
+    index_->blocks_ = index_->owned_blocks_;
+    index_->strings_ = index_->owned_strings_;
+  }
+
+ private:
+  StringRef AddString(std::string_view str) {
+    StringRef ref;
+    ref.offset = static_cast<uint32_t>(index_->owned_strings_.size());
+    ref.length = static_cast<uint32_t>(str.size());
+    index_->owned_strings_.append(str);
+    return ref;
+  }
+
+  // Fills entry |index| from |node|. |path| holds the entry's full path and
+  // |name_length| the length of its last component.
+  void FillEntry(uint32_t index,
+                 const base::Value::Dict& node,
+                 std::string& path,
+                 size_t name_length) {
+    // |entries_| may grow while recursing, so always re-fetch the entry.
+    auto entry = [this, index]() -> Entry& {
+      return index_->owned_entries_[index];
+    };
+
+    const StringRef path_ref = AddString(path);
+    entry().path = path_ref;
+    entry().name = {path_ref.offset + path_ref.length -
+                        static_cast<uint32_t>(name_length),
+                    static_cast<uint32_t>(name_length)};
+
+    if (const std::string* link = node.FindString("link")) {
+      entry().type = EntryType::kLink;
+      entry().link = AddString(*link);
+      return;
+    }
+
+    FillFileInfo(entry(), node);
+
+    const base::Value::Dict* files = node.FindDict("files");
+    if (!files)
+      return;
+
+    uint32_t child_count = 0U;
+    for (const auto [name, value] : *files) {
+      if (value.is_dict())
+        ++child_count;
+    }
+
+    // Reserve the whole children range up front so that siblings stay
+    // contiguous. base::Value::Dict iterates in key order, which keeps each
+    // range sorted by name.
+    const auto first_child =
+        static_cast<uint32_t>(index_->owned_entries_.size());
+    index_->owned_entries_.resize(first_child + child_count);
+    entry().type = EntryType::kDirectory;
+    entry().first_child = first_child;
+    entry().child_count = child_count;
+
+    uint32_t child = first_child;
+    for (const auto [name, value] : *files) {
+      if (!value.is_dict())
+        continue;
+      const size_t parent_length = path.size();
+      if (!path.empty())
+        path.push_back('/');
+      path.append(name);
+      FillEntry(child++, value.GetDict(), path, name.size());
+      path.resize(parent_length);
+    }
+  }
+
+  void FillFileInfo(Entry& entry, const base::Value::Dict& node) {
+    std::optional<int> size = node.FindInt("size");
+    if (!size)
+      return;
+    entry.size = static_cast<uint32_t>(*size);
+
+    if (node.FindBool("unpacked").value_or(false)) {
+      entry.flags |= kUnpacked | kHasFileInfo;
+      return;
+    }
+
+    const std::string* offset = node.FindString("offset");
+    if (!offset ||
+        !base::StringToUint64(std::string_view{*offset}, &entry.offset))
+      return;
+    entry.flags |= kHasFileInfo;
+
+    if (node.FindBool("executable").value_or(false))
+      entry.flags |= kExecutable;
+
+    if (load_integrity_)
+      FillIntegrity(entry, node);
+  }
+
+  void FillIntegrity(Entry& entry, const base::Value::Dict& node) {
+    const base::Value::Dict* integrity = node.FindDict("integrity");
+    if (!integrity)
+      return;
+
+    const std::string* algorithm = integrity->FindString("algorithm");
+    const std::string* hash = integrity->FindString("hash");
+    std::optional<int> block_size = integrity->FindInt("blockSize");
+    const base::Value::List* blocks = integrity->FindList("blocks");
+    if (!algorithm || !hash || !block_size || *block_size <= 0 || !blocks)
+      return;
+
+    for (const auto& value : *blocks) {
+      if (!value.is_string()) {
+        entry.flags |= kInvalidIntegrity;
+        return;
+      }
+    }
+
+    // Only SHA256 is currently supported.
+    if (*algorithm != "SHA256")
+      return;
+
+    Integrity record;
+    record.hash = AddString(*hash);
+    record.block_size = static_cast<uint32_t>(*block_size);
+    record.first_block = static_cast<uint32_t>(index_->owned_blocks_.size());
+    record.block_count = static_cast<uint32_t>(blocks->size());
+    for (const auto& value : *blocks)
+      index_->owned_blocks_.push_back(AddString(value.GetString()));
+
+    entry.integrity = static_cast<uint32_t>(index_->owned_integrity_.size());
+    index_->owned_integrity_.push_back(record);
+  }
+
+  const raw_ptr<ArchiveIndex> index_;
+  const bool load_integrity_;
+};
+
+ArchiveIndex::ArchiveIndex() = default;
+ArchiveIndex::~ArchiveIndex() = default;
+
+// static
+std::unique_ptr<ArchiveIndex> ArchiveIndex::Build(
+    const base::Value::Dict& header,
+    bool load_integrity) {
+  auto index = base::WrapUnique(new ArchiveIndex());
+  Builder{index.get(), load_integrity}.Build(header);
+  return index;
+}
+
+// static
+std::unique_ptr<ArchiveIndex> ArchiveIndex::Load(const base::FilePath& path,
+                                                 const Source& source) {
+  auto mapped_file = std::make_unique<base::MemoryMappedFile>();
+  {
+    electron::ScopedAllowBlockingForElectron allow_blocking;
+    if (!mapped_file->Initialize(path))
+      return nullptr;
+  }
+
+  base::span<const uint8_t> bytes = mapped_file->bytes();
+  if (bytes.size() < sizeof(IndexFileHeader))
+    return nullptr;
+
+  IndexFileHeader header;
+  base::byte_span_from_ref(header).copy_from(
+      bytes.first<sizeof(IndexFileHeader)>());
+  if (header.magic != kIndexFileMagic ||
+      header.version != kIndexFileVersion ||
+      header.archive_size != source.archive_size ||
+      header.archive_mtime != source.archive_mtime ||
+      header.header_size != source.header_size ||
+      header.header_hash != source.header_hash) {
+    return nullptr;
+  }
+
+  const std::optional<IndexFileLayout> layout =
+      GetIndexFileLayout(header.entry_count, header.strings_size);
+  if (!layout || layout->total_size != bytes.size()) {
+    LOG(WARNING) << "Ignoring truncated asar index " << path.value();
+    return nullptr;
+  }
+
+  auto index = base::WrapUnique(new ArchiveIndex());
+  // The mapping is page aligned and every table starts on an 8-byte boundary,
+  // so the tables can be viewed in place.
+  index->entries_ = UNSAFE_BUFFERS(base::span(
+      reinterpret_cast<const Entry*>(bytes.data() + layout->entries_offset),
+      header.entry_count));
+  index->sorted_ = UNSAFE_BUFFERS(base::span(
+      reinterpret_cast<const uint32_t*>(bytes.data() + layout->sorted_offset),
+      header.entry_count));
+  index->strings_ = base::as_string_view(
+      bytes.subspan(layout->strings_offset, header.strings_size));
+  index->mapped_file_ = std::move(mapped_file);
+
+  if (!index->Validate()) {
+    LOG(WARNING) << "Ignoring malformed asar index " << path.value();
+    return nullptr;
+  }
+
+  return index;
+}
+
+bool ArchiveIndex::Write(const base::FilePath& path,
+                         const Source& source) const {
+  if (!integrity_.empty())
+    return false;
+
+  IndexFileHeader header;
+  header.archive_size = source.archive_size;
+  header.archive_mtime = source.archive_mtime;
+  header.header_size = source.header_size;
+  header.header_hash = source.header_hash;
+  header.entry_count = static_cast<uint32_t>(entries_.size());
+  header.strings_size = static_cast<uint32_t>(strings_.size());
+
+  const std::optional<IndexFileLayout> layout =
+      GetIndexFileLayout(header.entry_count, header.strings_size);
+  if (!layout)
+    return false;
+
+  std::string contents(layout->total_size, '\0');
+  auto out = base::as_writable_byte_span(contents);
+  out.copy_prefix_from(base::byte_span_from_ref(header));
+  out.subspan(layout->entries_offset)
+      .copy_prefix_from(base::as_byte_span(entries_));
+  out.subspan(layout->sorted_offset)
+      .copy_prefix_from(base::as_byte_span(sorted_));
+  out.subspan(layout->strings_offset).copy_from(base::as_byte_span(strings_));
+
+  electron::ScopedAllowBlockingForElectron allow_blocking;
+  return base::ImportantFileWriter::WriteFileAtomically(path, contents);
+}
+
+bool ArchiveIndex::Validate() const {
+  const size_t entry_count = entries_.size();
+  if (entry_count == 0 || sorted_.size() != entry_count)
+    return false;
+
+  auto valid_string = [this](const StringRef& ref) {
+    return ref.offset <= strings_.size() &&
+           ref.length <= strings_.size() - ref.offset;
+  };
+
+  for (const Entry& e : entries_) {
+    if (!valid_string(e.path) || !valid_string(e.name) ||
+        !valid_string(e.link)) {
+      return false;
+    }
+    if (e.type != EntryType::kFile && e.type != EntryType::kDirectory &&
+        e.type != EntryType::kLink) {
+      return false;
+    }
+    if (e.first_child > entry_count ||
+        e.child_count > entry_count - e.first_child) {
+      return false;
+    }
+    if (e.integrity != kNoIntegrity)
+      return false;
+  }
+
+  return std::ranges::all_of(
+      sorted_, [entry_count](uint32_t i) { return i < entry_count; });
+}
+
+uint32_t ArchiveIndex::Find(std::string_view path, int link_depth) const {
+  if (path.empty())
+    return kRootEntry;
+
+  // Fast path: the path names an entry directly.
+  const auto it =
+      std::ranges::lower_bound(sorted_, path, {}, [this](uint32_t i) {
+        return GetString(entry(i).path);
+      });
+  if (it != sorted_.end() && GetString(entry(*it).path) == path)
+    return *it;
+
+  // Slow path: walk the components, following directory links and accepting
+  // any separator the platform allows.
+  uint32_t current = kRootEntry;
+  for (size_t pos = path.find_first_of(kSeparators);
+       pos != std::string_view::npos; pos = path.find_first_of(kSeparators)) {
+    current = FindChild(current, path.substr(0, pos), link_depth);
+    if (current == kNoEntry)
+      return kNoEntry;
+    path.remove_prefix(pos + 1);
+  }
+
+  return FindChild(current, path, link_depth);
+}
+
+uint32_t ArchiveIndex::ResolveDirectory(uint32_t index, int link_depth) const {
+  const Entry* dir = &entry(index);
+  if (dir->type == EntryType::kLink) {
+    if (link_depth >= kMaxLinkDepth)
+      return kNoEntry;
+    index = Find(GetString(dir->link), link_depth + 1);
+    if (index == kNoEntry)
+      return kNoEntry;
+    dir = &entry(index);
+  }
+
+  return dir->type == EntryType::kDirectory ? index : kNoEntry;
+}
+
+uint32_t ArchiveIndex::FindChild(uint32_t dir,
+                                 std::string_view name,
+                                 int link_depth) const {
+  if (name.empty())
+    return kRootEntry;
+
+  dir = ResolveDirectory(dir, link_depth);
+  if (dir == kNoEntry)
+    return kNoEntry;
+
+  const base::span<const Entry> range = children(entry(dir));
+  const auto it = std::ranges::lower_bound(
+      range, name, {}, [this](const Entry& e) { return GetString(e.name); });
+  if (it == range.end() || GetString(it->name) != name)
+    return kNoEntry;
+
+  return entry(dir).first_child +
+         static_cast<uint32_t>(std::distance(range.begin(), it));
+}
+
+}  // namespace asar
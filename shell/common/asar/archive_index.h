@@ -0,0 +1,195 @@
+// Copyright (c) 2026 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_ASAR_ARCHIVE_INDEX_H_
+#define ELECTRON_SHELL_COMMON_ASAR_ARCHIVE_INDEX_H_
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base/containers/span.h"
+#include "base/memory/raw_span.h"
+#include "base/values.h"
+
+namespace base {
+class FilePath;
+class MemoryMappedFile;
+}  // namespace base
+
+namespace asar {
+
+// A flattened, read-only representation of an asar header.
+//
+// The JSON header is converted once into a contiguous table of entries plus a
+// single string arena holding every entry's full path. The children of a
+// directory occupy a contiguous, name-sorted range of the entry table, and a
+// separate table of entry indices sorted by full path lets most lookups be
+// answered with one binary search and no per-call allocation.
+//
+// Since every table is position independent, an index can also be written to
+// an index file next to the archive and later mapped read-only, letting all
+// processes share one copy of it instead of parsing the JSON header again.
+class ArchiveIndex {
+ public:
+  static constexpr uint32_t kRootEntry = 0U;
+  static constexpr uint32_t kNoEntry = std::numeric_limits<uint32_t>::max();
+  static constexpr uint32_t kNoIntegrity = std::numeric_limits<uint32_t>::max();
+
+  enum class EntryType : uint8_t {
+    kFile,
+    kDirectory,
+    kLink,
+  };
+
+  enum EntryFlags : uint8_t {
+    // The entry has enough information to fill an Archive::FileInfo.
+    kHasFileInfo = 1 << 0,
+    kUnpacked = 1 << 1,
+    kExecutable = 1 << 2,
+    // The entry carried an integrity payload that could not be parsed.
+    kInvalidIntegrity = 1 << 3,
+  };
+
+  // A range of bytes in the string arena.
+  struct StringRef {
+    uint32_t offset = 0U;
+    uint32_t length = 0U;
+  };
+
+  struct Entry {
+    // Full path of the entry relative to the archive root, using '/'.
+    StringRef path;
+    // Last component of |path|.
+    StringRef name;
+    // Target path of a kLink entry.
+    StringRef link;
+    // Children range of a kDirectory entry.
+    uint32_t first_child = 0U;
+    uint32_t child_count = 0U;
+    uint32_t size = 0U;
+    // Index into integrity(), or kNoIntegrity.
+    uint32_t integrity = kNoIntegrity;
+    // Offset of the file contents, relative to the end of the header.
+    uint64_t offset = 0U;
+    EntryType type = EntryType::kFile;
+    uint8_t flags = 0U;
+  };
+
+  struct Integrity {
+    StringRef hash;
+    uint32_t block_size = 0U;
+    // Range of block hashes in blocks().
+    uint32_t first_block = 0U;
+    uint32_t block_count = 0U;
+  };
+
+  // Identifies the archive an index file was generated from. An index file is
+  // only used when all of these match the archive being opened.
+  struct Source {
+    uint64_t archive_size = 0U;
+    // Last modification time, in microseconds since the Windows epoch.
+    int64_t archive_mtime = 0;
+    uint32_t header_size = 0U;
+    // SHA256 of the raw JSON header.
+    std::array<uint8_t, 32> header_hash = {};
+  };
+
+  ~ArchiveIndex();
+
+  // disable copy
+  ArchiveIndex(const ArchiveIndex&) = delete;
+  ArchiveIndex& operator=(const ArchiveIndex&) = delete;
+
+  // Flattens the parsed JSON |header|. Integrity payloads are only retained
+  // when |load_integrity| is true.
+  static std::unique_ptr<ArchiveIndex> Build(const base::Value::Dict& header,
+                                             bool load_integrity);
+
+  // Maps the index file at |path|. Returns nullptr if the file is missing,
+  // malformed, or was not generated from |source|.
+  static std::unique_ptr<ArchiveIndex> Load(const base::FilePath& path,
+                                            const Source& source);
+
+  // Writes the index to |path| so that a later Load() with the same |source|
+  // can use it. Indexes that retain integrity payloads are never written.
+  bool Write(const base::FilePath& path, const Source& source) const;
+
+  // Whether the tables are backed by a mapped index file.
+  bool is_mapped() const { return !!mapped_file_; }
+
+  // Links are followed at most this many times when resolving a path, which
+  // keeps a cyclic header from hanging or overflowing the stack.
+  static constexpr int kMaxLinkDepth = 40;
+
+  // Returns the index of the entry at |path|, or kNoEntry. Directory links in
+  // intermediate components are followed; a link at the final component is
+  // returned as-is.
+  uint32_t Find(std::string_view path) const { return Find(path, 0); }
+
+  // Returns the index of the directory whose children |index| lists, following
+  // a single level of directory link, or kNoEntry.
+  uint32_t ResolveDirectory(uint32_t index) const {
+    return ResolveDirectory(index, 0);
+  }
+
+  const Entry& entry(uint32_t index) const { return entries_[index]; }
+  size_t entry_count() const { return entries_.size(); }
+
+  base::span<const Entry> children(const Entry& dir) const {
+    return entries_.subspan(dir.first_child, dir.child_count);
+  }
+
+  const Integrity& integrity(uint32_t index) const {
+    return integrity_[index];
+  }
+  base::span<const StringRef> blocks(const Integrity& integrity) const {
+    return blocks_.subspan(integrity.first_block, integrity.block_count);
+  }
+
+  std::string_view GetString(const StringRef& ref) const {
+    return strings_.substr(ref.offset, ref.length);
+  }
+
+ private:
+  class Builder;
+
+  ArchiveIndex();
+
+  // |link_depth| is the number of links followed so far to get here.
+  uint32_t Find(std::string_view path, int link_depth) const;
+  uint32_t ResolveDirectory(uint32_t index, int link_depth) const;
+  uint32_t FindChild(uint32_t dir,
+                     std::string_view name,
+                     int link_depth) const;
+
+  // Checks that every reference between the tables is in bounds.
+  bool Validate() const;
+
+  // Tables of a built index.
+  std::vector<Entry> owned_entries_;
+  std::vector<uint32_t> owned_sorted_;
+  std::vector<Integrity> owned_integrity_;
+  std::vector<StringRef> owned_blocks_;
+  std::string owned_strings_;
+
+  // Mapping of a loaded index file.
+  std::unique_ptr<base::MemoryMappedFile> mapped_file_;
+
+  // Views of either the owned tables or the mapped file.
+  base::raw_span<const Entry> entries_;
+  // Indices into |entries_|, sorted by full path.
+  base::raw_span<const uint32_t> sorted_;
+  base::raw_span<const Integrity> integrity_;
+  base::raw_span<const StringRef> blocks_;
+  std::string_view strings_;
+};
+
+}  // namespace asar
+
+#endif  // ELECTRON_SHELL_COMMON_ASAR_ARCHIVE_INDEX_H_
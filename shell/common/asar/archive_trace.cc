@@ -0,0 +1,289 @@
+// Copyright (c) 2026 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/asar/archive_trace.h"
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/containers/span.h"
+#include "base/environment.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/functional/bind.h"
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+#include "base/process/process_handle.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/task/thread_pool.h"
+#include "base/task/thread_pool/thread_pool_instance.h"
+#include "build/build_config.h"
+#include "shell/common/process_util.h"
+#include "shell/common/thread_restrictions.h"
+
+#if BUILDFLAG(IS_POSIX)
+#include <fcntl.h>
+#endif
+
+namespace asar {
+
+namespace {
+
+// When set, archives opened by this process record the ranges read from them
+// into a trace file. The value is the recording window in seconds.
+const char kRecordTraceEnvVar[] = "ELECTRON_RECORD_ASAR_TRACE";
+
+constexpr base::TimeDelta kDefaultRecordWindow = base::Seconds(10);
+
+constexpr uint32_t kTraceFileMagic = 0x54525341;  // "ASRT"
+constexpr uint32_t kTraceFileVersion = 1U;
+
+// Traces are small; anything larger than this is not one of ours.
+constexpr int64_t kMaxTraceFileSize = 16 * 1024 * 1024;
+
+// Bounds the work done for a directory littered with stale recordings.
+constexpr size_t kMaxTraceFiles = 64U;
+
+// Recorded ranges this close to each other are hinted as a single range.
+constexpr uint64_t kMergeGap = 64 * 1024;
+
+struct TraceFileHeader {
+  uint32_t magic = kTraceFileMagic;
+  uint32_t version = kTraceFileVersion;
+  uint64_t archive_size = 0U;
+  // Last modification time, in microseconds since the Windows epoch.
+  int64_t archive_mtime = 0;
+};
+
+struct TraceRange {
+  uint64_t offset = 0U;
+  uint64_t length = 0U;
+};
+
+static_assert(sizeof(TraceFileHeader) == 24);
+static_assert(sizeof(TraceRange) == 16);
+
+std::string GetTraceProcessType() {
+  std::string process_type = electron::GetProcessType();
+  if (process_type.empty())
+    process_type = "browser";
+  return process_type;
+}
+
+// Matches the traces recorded by every process of the current type.
+base::FilePath::StringType GetArchiveTracePattern(
+    const base::FilePath& archive_path) {
+  return archive_path.BaseName()
+      .AddExtensionASCII(GetTraceProcessType())
+      .AddExtension(FILE_PATH_LITERAL("*"))
+      .AddExtension(FILE_PATH_LITERAL("trace"))
+      .value();
+}
+
+TraceFileHeader MakeTraceFileHeader(const base::File::Info& archive_info) {
+  TraceFileHeader header;
+  header.archive_size = static_cast<uint64_t>(archive_info.size);
+  header.archive_mtime =
+      archive_info.last_modified.ToDeltaSinceWindowsEpoch().InMicroseconds();
+  return header;
+}
+
+void ReadAhead(base::File& file, const TraceRange& range) {
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS)
+  posix_fadvise(file.GetPlatformFile(), static_cast<off_t>(range.offset),
+                static_cast<off_t>(range.length), POSIX_FADV_WILLNEED);
+#elif BUILDFLAG(IS_MAC)
+  radvisory advice;
+  advice.ra_offset = static_cast<off_t>(range.offset);
+  advice.ra_count = static_cast<int>(
+      std::min<uint64_t>(range.length, std::numeric_limits<int>::max()));
+  fcntl(file.GetPlatformFile(), F_RDADVISE, &advice);
+#else
+  // Without an advisory API, reading the range is what populates the cache.
+  std::vector<uint8_t> buffer(std::min<uint64_t>(range.length, kMergeGap));
+  for (uint64_t done = 0U; done < range.length;) {
+    const size_t chunk = std::min<uint64_t>(buffer.size(), range.length - done);
+    const std::optional<size_t> read =
+        file.Read(range.offset + done, base::span(buffer).first(chunk));
+    if (!read || *read == 0U)
+      return;
+    done += *read;
+  }
+#endif
+}
+
+// Appends the ranges recorded in |trace_path| that are not in |seen| yet.
+// Returns false if the trace is unreadable or was recorded against another
+// archive.
+bool ReadTraceRanges(const base::FilePath& trace_path,
+                     const TraceFileHeader& expected,
+                     absl::flat_hash_set<uint64_t>& seen,
+                     std::vector<TraceRange>& ranges) {
+  std::string contents;
+  if (!base::ReadFileToStringWithMaxSize(trace_path, &contents,
+                                         kMaxTraceFileSize)) {
+    return false;
+  }
+
+  const auto bytes = base::as_byte_span(contents);
+  if (bytes.size() < sizeof(TraceFileHeader))
+    return false;
+
+  TraceFileHeader header;
+  base::byte_span_from_ref(header).copy_from(
+      bytes.first(sizeof(TraceFileHeader)));
+  if (header.magic != expected.magic || header.version != expected.version ||
+      header.archive_size != expected.archive_size ||
+      header.archive_mtime != expected.archive_mtime) {
+    return false;
+  }
+
+  auto remaining = bytes.subspan(sizeof(TraceFileHeader));
+  while (remaining.size() >= sizeof(TraceRange)) {
+    TraceRange range;
+    base::byte_span_from_ref(range).copy_from(
+        remaining.first(sizeof(TraceRange)));
+    remaining = remaining.subspan(sizeof(TraceRange));
+
+    if (range.offset > header.archive_size ||
+        range.length > header.archive_size - range.offset) {
+      return false;
+    }
+    if (seen.insert(range.offset).second)
+      ranges.push_back(range);
+  }
+  return true;
+}
+
+void PrefetchRanges(base::File archive_file,
+                    const TraceFileHeader& expected,
+                    const base::FilePath& archive_path,
+                    const base::FilePath::StringType& pattern) {
+  // Enumeration order is unspecified; sort so that replays are stable.
+  std::vector<base::FilePath> trace_paths;
+  base::FileEnumerator enumerator(archive_path.DirName(), false,
+                                  base::FileEnumerator::FILES, pattern);
+  for (base::FilePath path = enumerator.Next(); !path.empty();
+       path = enumerator.Next()) {
+    trace_paths.push_back(std::move(path));
+  }
+  std::ranges::sort(trace_paths);
+  if (trace_paths.size() > kMaxTraceFiles)
+    trace_paths.resize(kMaxTraceFiles);
+
+  // Each process's ranges are replayed in its recorded order, since that is
+  // the order in which startup is going to need them. Ranges another process
+  // already touched are skipped.
+  absl::flat_hash_set<uint64_t> seen;
+  std::vector<TraceRange> ranges;
+  for (const base::FilePath& trace_path : trace_paths) {
+    const size_t previous_size = ranges.size();
+    if (!ReadTraceRanges(trace_path, expected, seen, ranges))
+      ranges.resize(previous_size);
+  }
+
+  // Only neighbours are merged, to keep the recorded order.
+  std::optional<TraceRange> pending;
+  for (const TraceRange& range : ranges) {
+    if (pending && range.offset >= pending->offset &&
+        range.offset <= pending->offset + pending->length + kMergeGap) {
+      pending->length = std::max(pending->length,
+                                 range.offset + range.length - pending->offset);
+      continue;
+    }
+    if (pending)
+      ReadAhead(archive_file, *pending);
+    pending = range;
+  }
+  if (pending)
+    ReadAhead(archive_file, *pending);
+}
+
+}  // namespace
+
+// static
+std::unique_ptr<ArchiveTraceRecorder> ArchiveTraceRecorder::MaybeCreate(
+    const base::FilePath& trace_path,
+    const base::File::Info& archive_info) {
+  std::string value;
+  if (!base::Environment::Create()->GetVar(kRecordTraceEnvVar, &value))
+    return nullptr;
+
+  base::TimeDelta window = kDefaultRecordWindow;
+  if (int seconds = 0; base::StringToInt(value, &seconds) && seconds > 0)
+    window = base::Seconds(seconds);
+
+  electron::ScopedAllowBlockingForElectron allow_blocking;
+  base::File file(trace_path,
+                  base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+  if (!file.IsValid()) {
+    LOG(WARNING) << "Failed to create asar trace " << trace_path.value()
+                 << ": " << base::File::ErrorToString(file.error_details());
+    return nullptr;
+  }
+
+  const TraceFileHeader header = MakeTraceFileHeader(archive_info);
+  if (!file.WriteAtCurrentPosAndCheck(base::byte_span_from_ref(header)))
+    return nullptr;
+
+  return base::WrapUnique(new ArchiveTraceRecorder(
+      std::move(file), base::TimeTicks::Now() + window));
+}
+
+ArchiveTraceRecorder::ArchiveTraceRecorder(base::File file,
+                                           base::TimeTicks deadline)
+    : file_{std::move(file)}, deadline_{deadline} {}
+
+ArchiveTraceRecorder::~ArchiveTraceRecorder() {
+  electron::ScopedAllowBlockingForElectron allow_blocking;
+  file_.Close();
+}
+
+void ArchiveTraceRecorder::RecordRead(uint64_t offset, uint64_t length) {
+  base::AutoLock auto_lock(lock_);
+  if (!file_.IsValid())
+    return;
+
+  electron::ScopedAllowBlockingForElectron allow_blocking;
+  if (base::TimeTicks::Now() >= deadline_) {
+    file_.Close();
+    recorded_offsets_.clear();
+    return;
+  }
+
+  // Only the first touch of a range matters for ordering.
+  if (!recorded_offsets_.insert(offset).second)
+    return;
+
+  const TraceRange range{offset, length};
+  if (!file_.WriteAtCurrentPosAndCheck(base::byte_span_from_ref(range)))
+    file_.Close();
+}
+
+base::FilePath GetArchiveTraceRecordPath(const base::FilePath& archive_path) {
+  return archive_path.AddExtensionASCII(GetTraceProcessType())
+      .AddExtensionASCII(base::NumberToString(base::GetCurrentProcId()))
+      .AddExtension(FILE_PATH_LITERAL("trace"));
+}
+
+void PrefetchArchiveTrace(base::File archive_file,
+                          const base::File::Info& archive_info,
+                          const base::FilePath& archive_path) {
+  if (!archive_file.IsValid() || !base::ThreadPoolInstance::Get())
+    return;
+
+  base::ThreadPool::PostTask(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
+      base::BindOnce(&PrefetchRanges, std::move(archive_file),
+                     MakeTraceFileHeader(archive_info), archive_path,
+                     GetArchiveTracePattern(archive_path)));
+}
+
+}  // namespace asar
@@ -0,0 +1,69 @@
+// Copyright (c) 2026 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_ASAR_ARCHIVE_TRACE_H_
+#define ELECTRON_SHELL_COMMON_ASAR_ARCHIVE_TRACE_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "third_party/abseil-cpp/absl/container/flat_hash_set.h"
+
+namespace asar {
+
+// Records, in order, the ranges of an archive that a process reads during
+// startup. On later launches the recording is replayed as read-ahead hints
+// from a background task, so that the OS fetches those ranges before they are
+// requested.
+//
+// Recording is enabled by the ELECTRON_RECORD_ASAR_TRACE environment
+// variable. Each process records into its own trace file next to the archive,
+// named after its process type and pid, e.g. app.asar.renderer.1234.trace, so
+// that concurrent renderers never write to the same file.
+class ArchiveTraceRecorder {
+ public:
+  // Returns a recorder writing to |trace_path| if recording is enabled.
+  static std::unique_ptr<ArchiveTraceRecorder> MaybeCreate(
+      const base::FilePath& trace_path,
+      const base::File::Info& archive_info);
+
+  ~ArchiveTraceRecorder();
+
+  // disable copy
+  ArchiveTraceRecorder(const ArchiveTraceRecorder&) = delete;
+  ArchiveTraceRecorder& operator=(const ArchiveTraceRecorder&) = delete;
+
+  // Appends a read of |length| bytes at |offset| in the archive. Reads after
+  // the recording window has elapsed are ignored.
+  void RecordRead(uint64_t offset, uint64_t length);
+
+ private:
+  ArchiveTraceRecorder(base::File file, base::TimeTicks deadline);
+
+  base::Lock lock_;
+  base::File file_;
+  const base::TimeTicks deadline_;
+  absl::flat_hash_set<uint64_t> recorded_offsets_;
+};
+
+// Returns the trace file the current process records into for
+// |archive_path|.
+base::FilePath GetArchiveTraceRecordPath(const base::FilePath& archive_path);
+
+// Issues read-ahead hints from a background task for the ranges recorded by
+// processes of the current type in the traces next to |archive_path|. Traces
+// recorded against an archive not matching |archive_info| are ignored; the
+// others are merged, each range being replayed once. |archive_file| is only
+// used for the hints.
+void PrefetchArchiveTrace(base::File archive_file,
+                          const base::File::Info& archive_info,
+                          const base::FilePath& archive_path);
+
+}  // namespace asar
+
+#endif  // ELECTRON_SHELL_COMMON_ASAR_ARCHIVE_TRACE_H_
@@ -4,18 +4,32 @@
 
 #include "shell/common/asar/asar_util.h"
 
+#include <algorithm>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
+#include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/functional/bind.h"
 #include "base/logging.h"
+#include "base/memory/ref_counted.h"
 #include "base/no_destructor.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
+#include "base/strings/string_view_util.h"
 #include "base/synchronization/lock.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/system/sys_info.h"
+#include "base/task/thread_pool.h"
+#include "base/task/thread_pool/thread_pool_instance.h"
 #include "base/threading/thread_local.h"
+#include "base/threading/thread_restrictions.h"
 #include "crypto/hash.h"
 #include "shell/common/asar/archive.h"
 #include "shell/common/thread_restrictions.h"
@@ -54,6 +68,62 @@ base::Lock& GetArchiveCacheLock() {
   return *lock;
 }
 
+void ValidateSHA256OrDie(base::span<const uint8_t> input,
+                         std::string_view expected_hash) {
+  const std::string hex_hash =
+      base::ToLowerASCII(base::HexEncode(crypto::hash::Sha256(input)));
+  if (expected_hash != hex_hash) {
+    LOG(FATAL) << "Integrity check failed for asar archive (" << expected_hash
+               << " vs " << hex_hash << ")";
+  }
+}
+
+// The use of the ForTesting flavor is a hack workaround to avoid having to
+// patch this as a friend into the associated guard class.
+class [[maybe_unused, nodiscard]] IntegrityScopedAllowBaseSyncPrimitives
+    : public base::ScopedAllowBaseSyncPrimitivesForTesting {};
+
+// Validates a set of blocks on the calling thread and on thread pool workers
+// at the same time. Blocks are claimed one at a time, so the caller only ever
+// waits for blocks that a worker has already started on, and a worker that
+// starts late finds nothing left to do.
+class IntegrityBlocksJob
+    : public base::RefCountedThreadSafe<IntegrityBlocksJob> {
+ public:
+  explicit IntegrityBlocksJob(std::vector<IntegrityBlock> blocks)
+      : blocks_{std::move(blocks)}, remaining_{blocks_.size()} {}
+
+  // disable copy
+  IntegrityBlocksJob(const IntegrityBlocksJob&) = delete;
+  IntegrityBlocksJob& operator=(const IntegrityBlocksJob&) = delete;
+
+  size_t size() const { return blocks_.size(); }
+
+  void Run() {
+    for (size_t i = next_++; i < blocks_.size(); i = next_++) {
+      ValidateSHA256OrDie(blocks_[i].data, blocks_[i].hash);
+      if (--remaining_ == 0)
+        done_.Signal();
+    }
+  }
+
+  void RunAndWait() {
+    Run();
+    electron::ScopedAllowBlockingForElectron allow_blocking;
+    IntegrityScopedAllowBaseSyncPrimitives allow_base_sync_primitives;
+    done_.Wait();
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<IntegrityBlocksJob>;
+  ~IntegrityBlocksJob() = default;
+
+  const std::vector<IntegrityBlock> blocks_;
+  std::atomic<size_t> next_ = 0U;
+  std::atomic<size_t> remaining_;
+  base::WaitableEvent done_;
+};
+
 }  // namespace
 
 std::shared_ptr<Archive> GetOrCreateAsarArchive(const base::FilePath& path) {
@@ -120,6 +190,13 @@ bool ReadFileToString(const base::FilePath& path, std::string* contents) {
     return base::ReadFileToString(real_path, contents);
   }
 
+  if (const std::optional<base::span<const uint8_t>> data =
+          archive->GetFileContents(info)) {
+    contents->assign(base::as_string_view(*data));
+    return true;
+  }
+
+  // The archive couldn't be mapped, so read the file from it instead.
   base::File src(asar_path, base::File::FLAG_OPEN | base::File::FLAG_READ);
   if (!src.IsValid())
     return false;
@@ -137,15 +214,29 @@ bool ReadFileToString(const base::FilePath& path, std::string* contents) {
 void ValidateIntegrityOrDie(base::span<const uint8_t> input,
                             const IntegrityPayload& integrity) {
   if (integrity.algorithm == HashAlgorithm::kSHA256) {
-    const std::string hex_hash =
-        base::ToLowerASCII(base::HexEncode(crypto::hash::Sha256(input)));
-    if (integrity.hash != hex_hash) {
-      LOG(FATAL) << "Integrity check failed for asar archive ("
-                 << integrity.hash << " vs " << hex_hash << ")";
-    }
+    ValidateSHA256OrDie(input, integrity.hash);
   } else {
     LOG(FATAL) << "Unsupported hashing algorithm in ValidateIntegrityOrDie";
   }
 }
 
+void ValidateIntegrityBlocksOrDie(std::vector<IntegrityBlock> blocks) {
+  if (blocks.size() <= 1 || !base::ThreadPoolInstance::Get()) {
+    for (const IntegrityBlock& block : blocks)
+      ValidateSHA256OrDie(block.data, block.hash);
+    return;
+  }
+
+  auto job = base::MakeRefCounted<IntegrityBlocksJob>(std::move(blocks));
+  const size_t workers =
+      std::min(job->size() - 1,
+               static_cast<size_t>(base::SysInfo::NumberOfProcessors()) - 1);
+  for (size_t i = 0; i < workers; ++i) {
+    base::ThreadPool::PostTask(
+        FROM_HERE, {base::TaskPriority::USER_BLOCKING},
+        base::BindOnce(&IntegrityBlocksJob::Run, job));
+  }
+  job->RunAndWait();
+}
+
 }  // namespace asar
@@ -7,8 +7,10 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/containers/span.h"
+#include "base/memory/raw_span.h"
 
 namespace base {
 class FilePath;
@@ -34,6 +36,16 @@ bool ReadFileToString(const base::FilePath& path, std::string* contents);
 void ValidateIntegrityOrDie(base::span<const uint8_t> input,
                             const IntegrityPayload& integrity);
 
+// One block of a packed file and its expected SHA256 hash.
+struct IntegrityBlock {
+  base::raw_span<const uint8_t> data;
+  std::string hash;
+};
+
+// Validates every block in |blocks|. When there is more than one block, the
+// work is shared with the thread pool.
+void ValidateIntegrityBlocksOrDie(std::vector<IntegrityBlock> blocks);
+
 }  // namespace asar
 
 #endif  // ELECTRON_SHELL_COMMON_ASAR_ASAR_UTIL_H_
@@ -49,6 +49,16 @@ bool ScopedTemporaryFile::Init(const base::FilePath::StringType& ext) {
   return true;
 }
 
+bool ScopedTemporaryFile::InitFromBytes(const base::FilePath::StringType& ext,
+                                        base::span<const uint8_t> data) {
+  if (!Init(ext))
+    return false;
+
+  electron::ScopedAllowBlockingForElectron allow_blocking;
+  base::File dest(path_, base::File::FLAG_OPEN | base::File::FLAG_WRITE);
+  return dest.IsValid() && dest.WriteAtCurrentPosAndCheck(data);
+}
+
 bool ScopedTemporaryFile::InitFromFile(
     base::File* src,
     const base::FilePath::StringType& ext,
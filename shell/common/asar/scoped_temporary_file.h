@@ -7,6 +7,7 @@
 
 #include <optional>
 
+#include "base/containers/span.h"
 #include "base/files/file_path.h"
 #include "shell/common/asar/archive.h"
 
@@ -30,6 +31,10 @@ class ScopedTemporaryFile {
   // Init an empty temporary file with a certain extension.
   bool Init(const base::FilePath::StringType& ext);
 
+  // Init a temporary file and fill it with |data|.
+  bool InitFromBytes(const base::FilePath::StringType& ext,
+                     base::span<const uint8_t> data);
+
   // Init an temporary file and fill it with content of |path|.
   bool InitFromFile(base::File* src,
                     const base::FilePath::StringType& ext,
@@ -9,6 +9,7 @@
 #include "shell/browser/javascript_environment.h"
 #include "shell/common/gin_converters/blink_converter.h"
 #include "shell/common/gin_helper/handle.h"
+#include "shell/common/v8_util.h"
 #include "v8/include/cppgc/allocation.h"
 #include "v8/include/v8-cppgc.h"
 
@@ -48,7 +49,7 @@ bool ReplyChannel::SendReplyImpl(v8::Isolate* isolate,
     return false;
 
   blink::CloneableMessage msg;
-  if (!gin::ConvertFromV8(isolate, arg, &msg))
+  if (!electron::SerializeV8ValueForIPC(isolate, arg, &msg))
     return false;
 
   std::move(callback).Run(std::move(msg));
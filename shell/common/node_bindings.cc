@@ -526,17 +526,20 @@ NodeBindings::NodeBindings(BrowserEnvironment browser_env)
       uv_loop_{InitEventLoop(browser_env, &worker_loop_)} {}
 
 NodeBindings::~NodeBindings() {
-  // Quit the embed thread.
-  embed_closed_ = true;
-  uv_sem_post(&embed_sem_);
+  if (!watch_backend_fd_) {
+    // Quit the embed thread.
+    embed_closed_ = true;
+    uv_sem_post(&embed_sem_);
 
-  WakeupEmbedThread();
+    WakeupEmbedThread();
 
-  // Wait for everything to be done.
-  uv_thread_join(&embed_thread_);
+    // Wait for everything to be done.
+    uv_thread_join(&embed_thread_);
+
+    uv_sem_destroy(&embed_sem_);
+  }
 
   // Clear uv.
-  uv_sem_destroy(&embed_sem_);
   dummy_uv_handle_.reset();
 
   // Clean up worker loop
@@ -934,6 +937,11 @@ void NodeBindings::PrepareEmbedThread() {
   // nothing to do.
   uv_async_init(uv_loop_, dummy_uv_handle_.get(), nullptr);
 
+  if (CanWatchBackendFd()) {
+    watch_backend_fd_ = true;
+    return;
+  }
+
   // Start worker that will interrupt main loop when having uv events.
   uv_sem_init(&embed_sem_, 0);
   uv_thread_create(&embed_thread_, EmbedThreadRunner, this);
@@ -953,6 +961,9 @@ void NodeBindings::StartPolling() {
 
   // Run uv loop for once to give the uv__io_poll a chance to add all events.
   UvRunOnce();
+
+  if (watch_backend_fd_)
+    StartWatchingBackendFd();
 }
 
 void NodeBindings::SetAppCodeLoaded() {
@@ -1008,7 +1019,7 @@ void NodeBindings::UvRunOnce() {
       TRACE_EVENT_BEGIN0("devtools.timeline", "FunctionCall");
 
     // Deal with uv events.
-    int r = uv_run(uv_loop_, UV_RUN_NOWAIT);
+    int r = RunUvLoopWithinBudget();
 
     if (browser_env_ != BrowserEnvironment::kBrowser)
       TRACE_EVENT_END0("devtools.timeline", "FunctionCall");
@@ -1018,7 +1029,40 @@ void NodeBindings::UvRunOnce() {
   }
 
   // Tell the worker thread to continue polling.
-  uv_sem_post(&embed_sem_);
+  if (!watch_backend_fd_)
+    uv_sem_post(&embed_sem_);
+}
+
+int NodeBindings::RunUvLoopWithinBudget() {
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+  ++uv_run_metrics_.wakeups;
+
+  int r = 0;
+  for (int i = 0; i < kMaxUvRunIterations; ++i) {
+    uv_metrics_t before;
+    uv_metrics_info(uv_loop_, &before);
+
+    r = uv_run(uv_loop_, UV_RUN_NOWAIT);
+    ++uv_run_metrics_.iterations;
+    if (r == 0)
+      break;
+
+    // Every iteration still runs the timers, idle and check handles that are
+    // due, but only an iteration that processed I/O earns another one, so
+    // busy timers or immediates alone can't keep the thread for the budget.
+    uv_metrics_t after;
+    uv_metrics_info(uv_loop_, &after);
+    if (after.events == before.events)
+      break;
+
+    if (base::TimeTicks::Now() - start_time >= kUvRunBudget) {
+      ++uv_run_metrics_.wakeups_over_budget;
+      break;
+    }
+  }
+
+  uv_run_metrics_.run_time += base::TimeTicks::Now() - start_time;
+  return r;
 }
 
 void NodeBindings::WakeupMainThread() {
@@ -15,6 +15,7 @@
 #include "base/memory/raw_ptr.h"
 #include "base/memory/raw_ptr_exclusion.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "base/types/to_address.h"
 #include "gin/public/context_holder.h"
 #include "gin/public/gin_embedders.h"
@@ -118,6 +119,20 @@ class NodeBindings {
  public:
   enum class BrowserEnvironment { kBrowser, kRenderer, kUtility, kWorker };
 
+  // Counters of the work done to run the libuv loop on the thread that owns
+  // it.
+  struct UvRunMetrics {
+    // Times the thread was woken up to run the loop.
+    uint64_t wakeups = 0U;
+    // Calls to uv_run(), of which there can be several per wakeup.
+    uint64_t iterations = 0U;
+    // Wakeups that stopped running the loop because they ran out of time
+    // while it still had I/O to process.
+    uint64_t wakeups_over_budget = 0U;
+    // Time spent in uv_run().
+    base::TimeDelta run_time;
+  };
+
   static std::unique_ptr<NodeBindings> Create(BrowserEnvironment browser_env);
   static void RegisterBuiltinBindings();
   static bool IsInitialized();
@@ -165,6 +180,10 @@ class NodeBindings {
 
   [[nodiscard]] constexpr uv_loop_t* uv_loop() { return uv_loop_; }
 
+  [[nodiscard]] const UvRunMetrics& uv_run_metrics() const {
+    return uv_run_metrics_;
+  }
+
   // disable copy
   NodeBindings(const NodeBindings&) = delete;
   NodeBindings& operator=(const NodeBindings&) = delete;
@@ -179,6 +198,20 @@ class NodeBindings {
   // Called to poll events in new thread.
   virtual void PollEvents() = 0;
 
+  // Returns whether the derived class can watch uv's backend fd from the
+  // current thread's message pump. If so, no embed thread is started and
+  // StartWatchingBackendFd() is called once polling starts instead, after
+  // which the derived class is responsible for calling UvRunOnce().
+  virtual bool CanWatchBackendFd() { return false; }
+  virtual void StartWatchingBackendFd() {}
+
+  // Run the libuv loop for once.
+  void UvRunOnce();
+
+  [[nodiscard]] constexpr BrowserEnvironment browser_env() const {
+    return browser_env_;
+  }
+
   // Make the main thread run libuv loop.
   void WakeupMainThread();
 
@@ -189,13 +222,20 @@ class NodeBindings {
   static uv_loop_t* InitEventLoop(BrowserEnvironment browser_env,
                                   uv_loop_t* worker_loop);
 
-  // Run the libuv loop for once.
-  void UvRunOnce();
+  // Runs uv_run(UV_RUN_NOWAIT) until the loop has no more I/O to process or
+  // kUvRunBudget is used up. Returns the result of the last uv_run().
+  int RunUvLoopWithinBudget();
 
   [[nodiscard]] constexpr bool in_worker_loop() const {
     return browser_env_ == BrowserEnvironment::kWorker;
   }
 
+  // A wakeup keeps running the loop while it finds I/O to process, for up to
+  // this long and this many iterations, so that bursts of small operations
+  // don't each need their own task.
+  static constexpr base::TimeDelta kUvRunBudget = base::Milliseconds(2);
+  static constexpr int kMaxUvRunIterations = 16;
+
   // Which environment we are running.
   const BrowserEnvironment browser_env_;
 
@@ -232,6 +272,10 @@ class NodeBindings {
   // Whether the libuv loop has ended.
   bool embed_closed_ = false;
 
+  // Whether uv's backend fd is watched from the main thread's message pump
+  // instead of from the embed thread.
+  bool watch_backend_fd_ = false;
+
   // Dummy handle to make uv's loop not quit.
   UvHandle<uv_async_t> dummy_uv_handle_;
 
@@ -244,6 +288,8 @@ class NodeBindings {
   // Environment that to wrap the uv loop.
   raw_ptr<node::Environment> uv_env_ = nullptr;
 
+  UvRunMetrics uv_run_metrics_;
+
   // Isolate data used in creating the environment
   raw_ptr<node::IsolateData> isolate_data_ = nullptr;
 
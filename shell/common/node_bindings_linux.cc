@@ -6,6 +6,18 @@
 
 #include <sys/epoll.h>
 
+#include "base/feature_list.h"
+#include "base/functional/bind.h"
+#include "base/task/current_thread.h"
+
+namespace features {
+// Runs libuv from the browser main thread's message pump instead of waking
+// the main thread from a separate polling thread.
+BASE_FEATURE(kUvMessagePumpIntegration,
+             "UvMessagePumpIntegration",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+}  // namespace features
+
 namespace electron {
 
 NodeBindingsLinux::NodeBindingsLinux(BrowserEnvironment browser_env)
@@ -19,6 +31,8 @@ NodeBindingsLinux::NodeBindingsLinux(BrowserEnvironment browser_env)
   epoll_ctl(epoll_, EPOLL_CTL_ADD, backend_fd, &ev);
 }
 
+NodeBindingsLinux::~NodeBindingsLinux() = default;
+
 void NodeBindingsLinux::PollEvents() {
   auto* const event_loop = uv_loop();
 
@@ -32,6 +46,43 @@ void NodeBindingsLinux::PollEvents() {
   } while (r == -1 && errno == EINTR);
 }
 
+bool NodeBindingsLinux::CanWatchBackendFd() {
+  // Only the browser process runs a message pump that can watch fds on the
+  // thread that owns the uv loop.
+  return browser_env() == BrowserEnvironment::kBrowser &&
+         base::CurrentUIThread::IsSet() &&
+         base::FeatureList::IsEnabled(features::kUvMessagePumpIntegration);
+}
+
+void NodeBindingsLinux::StartWatchingBackendFd() {
+  base::CurrentUIThread::Get()->WatchFileDescriptor(
+      uv_backend_fd(uv_loop()), true /* persistent */,
+      base::MessagePumpForUI::WATCH_READ, &backend_fd_watcher_, this);
+  ScheduleUvTimers();
+}
+
+void NodeBindingsLinux::OnFileCanReadWithoutBlocking(int fd) {
+  RunUvLoop();
+}
+
+void NodeBindingsLinux::RunUvLoop() {
+  UvRunOnce();
+  ScheduleUvTimers();
+}
+
+void NodeBindingsLinux::ScheduleUvTimers() {
+  const int timeout = uv_backend_timeout(uv_loop());
+  if (timeout < 0) {
+    uv_timer_.Stop();
+    return;
+  }
+
+  // base::Unretained is safe because |uv_timer_| is owned by this.
+  uv_timer_.Start(FROM_HERE, base::Milliseconds(timeout),
+                  base::BindOnce(&NodeBindingsLinux::RunUvLoop,
+                                 base::Unretained(this)));
+}
+
 // static
 std::unique_ptr<NodeBindings> NodeBindings::Create(BrowserEnvironment env) {
   return std::make_unique<NodeBindingsLinux>(env);
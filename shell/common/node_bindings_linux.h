@@ -5,20 +5,41 @@
 #ifndef ELECTRON_SHELL_COMMON_NODE_BINDINGS_LINUX_H_
 #define ELECTRON_SHELL_COMMON_NODE_BINDINGS_LINUX_H_
 
+#include "base/message_loop/message_pump_for_ui.h"
+#include "base/timer/timer.h"
 #include "shell/common/node_bindings.h"
 
 namespace electron {
 
-class NodeBindingsLinux : public NodeBindings {
+class NodeBindingsLinux : public NodeBindings,
+                          private base::MessagePumpForUI::FdWatcher {
  public:
   explicit NodeBindingsLinux(BrowserEnvironment browser_env);
+  ~NodeBindingsLinux() override;
 
  private:
   // NodeBindings
   void PollEvents() override;
+  bool CanWatchBackendFd() override;
+  void StartWatchingBackendFd() override;
+
+  // base::MessagePumpForUI::FdWatcher
+  void OnFileCanReadWithoutBlocking(int fd) override;
+  void OnFileCanWriteWithoutBlocking(int fd) override {}
+
+  // Runs the uv loop and schedules its next run for when its nearest timer
+  // is due.
+  void RunUvLoop();
+  void ScheduleUvTimers();
 
   // Epoll to poll for uv's backend fd.
   int epoll_;
+
+  // Used instead of the embed thread when uv's backend fd is watched from the
+  // main thread. The backend fd only becomes readable for I/O, so uv's timers
+  // are run from |uv_timer_|.
+  base::MessagePumpForUI::FdWatchController backend_fd_watcher_{FROM_HERE};
+  base::OneShotTimer uv_timer_;
 };
 
 }  // namespace electron
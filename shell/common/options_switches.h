@@ -188,6 +188,12 @@ inline constexpr std::string_view kSharedTexturePixelFormat =
 
 inline constexpr std::string_view kDeviceScaleFactor = "deviceScaleFactor";
 
+inline constexpr std::string_view kZeroCopy = "zeroCopy";
+
+inline constexpr std::string_view kDirtyRectOnly = "dirtyRectOnly";
+
+inline constexpr std::string_view kFramePacing = "framePacing";
+
 inline constexpr std::string_view kNodeIntegrationInSubFrames =
     "nodeIntegrationInSubFrames";
 
@@ -4,10 +4,14 @@
 
 #include "shell/common/v8_util.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <optional>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "base/containers/span.h"
 #include "base/memory/raw_ptr.h"
 #include "gin/converter.h"
 #include "shell/common/api/electron_api_native_image.h"
@@ -25,6 +29,429 @@ constexpr uint8_t kNativeImageTag = 'i';
 constexpr uint8_t kTrailerOffsetTag = 0xFE;
 constexpr uint8_t kVersionTag = 0xFF;
 
+// First byte of payloads in the compact encoding. Payloads written by
+// V8Serializer always start with kVersionTag.
+constexpr uint8_t kCompactFormatTag = 0xEC;
+
+// Tags of the values in the compact encoding.
+enum class CompactTag : uint8_t {
+  kUndefined = '_',
+  kNull = '0',
+  kTrue = 'T',
+  kFalse = 'F',
+  kInt32 = 'I',
+  kDouble = 'N',
+  kOneByteString = '"',
+  kTwoByteString = 'c',
+  kArray = 'A',
+  kObject = 'o',
+};
+
+// Payloads nested deeper than this, or made of more arrays and objects than
+// this, are left to V8Serializer.
+constexpr size_t kMaxCompactDepth = 32U;
+constexpr size_t kMaxCompactObjects = 256U;
+
+// The properties that the structured clone algorithm copies.
+constexpr auto kEnumerableStrings =
+    static_cast<v8::PropertyFilter>(v8::ONLY_ENUMERABLE | v8::SKIP_SYMBOLS);
+
+// Whether |object| is a function, a proxy, a host object or has an internal
+// slot that the structured clone algorithm copies or refuses to clone. These
+// are told apart by their slots rather than by their prototype, which can be
+// replaced.
+bool HasInternalSlots(v8::Local<v8::Object> object) {
+  if (object->IsApiWrapper() || object->InternalFieldCount() > 0)
+    return true;
+
+  return object->IsFunction() || object->IsDate() ||
+         object->IsArgumentsObject() || object->IsBigIntObject() ||
+         object->IsBooleanObject() || object->IsNumberObject() ||
+         object->IsStringObject() || object->IsSymbolObject() ||
+         object->IsNativeError() || object->IsRegExp() ||
+         object->IsPromise() || object->IsMap() || object->IsSet() ||
+         object->IsMapIterator() || object->IsSetIterator() ||
+         object->IsWeakMap() || object->IsWeakSet() ||
+         object->IsArrayBuffer() || object->IsArrayBufferView() ||
+         object->IsArray() || object->IsSharedArrayBuffer() ||
+         object->IsGeneratorObject() || object->IsWasmModuleObject() ||
+         object->IsWasmMemoryObject() || object->IsModuleNamespaceObject() ||
+         object->IsProxy();
+}
+
+// Writes payloads made only of primitives, arrays and plain objects without
+// going through v8::ValueSerializer and the Blink envelope. Anything else
+// makes it give up, including objects that are reachable more than once,
+// since the structured clone algorithm preserves their identity.
+//
+// It never runs JS: properties with accessors make it give up before any of
+// them is read, so that V8Serializer runs each getter only once.
+class CompactSerializer {
+ public:
+  explicit CompactSerializer(v8::Isolate* isolate)
+      : isolate_{isolate},
+        context_{isolate->GetCurrentContext()},
+        object_prototype_{v8::Object::New(isolate)->GetPrototypeV2()} {}
+
+  // Returns std::nullopt if |value| can't be written in the compact encoding
+  // or if reading it threw.
+  std::optional<std::vector<uint8_t>> Serialize(v8::Local<v8::Value> value) {
+    data_.push_back(kCompactFormatTag);
+    if (!WriteValue(value, 0U))
+      return std::nullopt;
+    return std::move(data_);
+  }
+
+ private:
+  bool WriteValue(v8::Local<v8::Value> value, size_t depth) {
+    if (value->IsUndefined()) {
+      WriteTag(CompactTag::kUndefined);
+    } else if (value->IsNull()) {
+      WriteTag(CompactTag::kNull);
+    } else if (value->IsTrue()) {
+      WriteTag(CompactTag::kTrue);
+    } else if (value->IsFalse()) {
+      WriteTag(CompactTag::kFalse);
+    } else if (value->IsInt32()) {
+      WriteTag(CompactTag::kInt32);
+      const int32_t number = value.As<v8::Int32>()->Value();
+      // ZigZag encoding, so that small negative numbers stay short.
+      WriteVarint((static_cast<uint32_t>(number) << 1U) ^
+                  static_cast<uint32_t>(number >> 31));
+    } else if (value->IsNumber()) {
+      WriteTag(CompactTag::kDouble);
+      const double number = value.As<v8::Number>()->Value();
+      const auto bytes = base::byte_span_from_ref(number);
+      data_.insert(data_.end(), bytes.begin(), bytes.end());
+    } else if (value->IsString()) {
+      WriteString(value.As<v8::String>());
+    } else if (value->IsArray()) {
+      return WriteArray(value.As<v8::Array>(), depth);
+    } else if (value->IsObject() && IsPlainObject(value.As<v8::Object>())) {
+      return WriteObject(value.As<v8::Object>(), depth);
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  void WriteString(v8::Local<v8::String> string) {
+    const uint32_t length = string->Length();
+    if (string->IsOneByte()) {
+      WriteTag(CompactTag::kOneByteString);
+      WriteVarint(length);
+      const size_t offset = data_.size();
+      data_.resize(offset + length);
+      string->WriteOneByteV2(isolate_, 0U, length,
+                             base::span(data_).subspan(offset).data());
+    } else {
+      WriteTag(CompactTag::kTwoByteString);
+      WriteVarint(length);
+      std::u16string chars(length, u'\0');
+      string->WriteV2(isolate_, 0U, length,
+                      reinterpret_cast<uint16_t*>(chars.data()));
+      const auto bytes = base::as_byte_span(chars);
+      data_.insert(data_.end(), bytes.begin(), bytes.end());
+    }
+  }
+
+  // Whether the structured clone algorithm copies |object| as an object with
+  // its own enumerable properties and nothing else. Only objects whose
+  // prototype is Object.prototype or null are accepted, which leaves
+  // instances of every other class, including those that can't be cloned at
+  // all, to V8Serializer.
+  bool IsPlainObject(v8::Local<v8::Object> object) const {
+    if (HasInternalSlots(object))
+      return false;
+    v8::Local<v8::Value> prototype = object->GetPrototypeV2();
+    return prototype->IsNull() || prototype == object_prototype_;
+  }
+
+  // Whether the own property |key| of |object| is an accessor, whose getter
+  // would run when it is read.
+  bool IsAccessor(v8::Local<v8::Object> object, v8::Local<v8::Value> key) {
+    return !key->IsString() ||
+           object->HasRealNamedCallbackProperty(context_, key.As<v8::Name>())
+               .FromMaybe(true);
+  }
+
+  bool WriteArray(v8::Local<v8::Array> array, size_t depth) {
+    if (!Visit(array, depth))
+      return false;
+
+    // Named properties and holes are cloned too, so arrays with either are
+    // left to V8Serializer.
+    v8::Local<v8::Array> names;
+    if (!array
+             ->GetPropertyNames(context_, v8::KeyCollectionMode::kOwnOnly,
+                                kEnumerableStrings,
+                                v8::IndexFilter::kSkipIndices)
+             .ToLocal(&names) ||
+        names->Length() > 0U) {
+      return false;
+    }
+
+    // With no named properties, the array has as many keys as its length
+    // only if it has no holes.
+    const uint32_t length = array->Length();
+    v8::Local<v8::Array> indices;
+    if (!array
+             ->GetPropertyNames(context_, v8::KeyCollectionMode::kOwnOnly,
+                                kEnumerableStrings,
+                                v8::IndexFilter::kIncludeIndices,
+                                v8::KeyConversionMode::kConvertToString)
+             .ToLocal(&indices) ||
+        indices->Length() != length) {
+      return false;
+    }
+    for (uint32_t i = 0U; i < length; ++i) {
+      v8::Local<v8::Value> index;
+      if (!indices->Get(context_, i).ToLocal(&index) ||
+          IsAccessor(array, index)) {
+        return false;
+      }
+    }
+
+    WriteTag(CompactTag::kArray);
+    WriteVarint(length);
+    for (uint32_t i = 0U; i < length; ++i) {
+      v8::Local<v8::Value> element;
+      if (!array->Get(context_, i).ToLocal(&element) ||
+          !WriteValue(element, depth + 1U)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool WriteObject(v8::Local<v8::Object> object, size_t depth) {
+    if (!Visit(object, depth))
+      return false;
+
+    v8::Local<v8::Array> keys;
+    if (!object
+             ->GetOwnPropertyNames(context_, kEnumerableStrings,
+                                   v8::KeyConversionMode::kConvertToString)
+             .ToLocal(&keys)) {
+      return false;
+    }
+
+    const uint32_t length = keys->Length();
+    for (uint32_t i = 0U; i < length; ++i) {
+      v8::Local<v8::Value> key;
+      if (!keys->Get(context_, i).ToLocal(&key) || IsAccessor(object, key))
+        return false;
+    }
+
+    WriteTag(CompactTag::kObject);
+    WriteVarint(length);
+    for (uint32_t i = 0U; i < length; ++i) {
+      v8::Local<v8::Value> key;
+      v8::Local<v8::Value> property;
+      if (!keys->Get(context_, i).ToLocal(&key) ||
+          !object->Get(context_, key).ToLocal(&property)) {
+        return false;
+      }
+      WriteString(key.As<v8::String>());
+      if (!WriteValue(property, depth + 1U))
+        return false;
+    }
+    return true;
+  }
+
+  bool Visit(v8::Local<v8::Object> object, size_t depth) {
+    if (depth >= kMaxCompactDepth || visited_.size() >= kMaxCompactObjects ||
+        std::ranges::find(visited_, object) != visited_.end()) {
+      return false;
+    }
+    visited_.push_back(object);
+    return true;
+  }
+
+  void WriteTag(CompactTag tag) { data_.push_back(static_cast<uint8_t>(tag)); }
+
+  void WriteVarint(uint32_t value) {
+    while (value >= 0x80U) {
+      data_.push_back(static_cast<uint8_t>(value) | 0x80U);
+      value >>= 7U;
+    }
+    data_.push_back(static_cast<uint8_t>(value));
+  }
+
+  raw_ptr<v8::Isolate> isolate_;
+  v8::Local<v8::Context> context_;
+  v8::Local<v8::Value> object_prototype_;
+  std::vector<v8::Local<v8::Object>> visited_;
+  std::vector<uint8_t> data_;
+};
+
+// Reads payloads written by CompactSerializer. They can come from a less
+// trusted process, so everything is bounds-checked.
+class CompactDeserializer {
+ public:
+  CompactDeserializer(v8::Isolate* isolate, base::span<const uint8_t> data)
+      : isolate_{isolate}, data_{data} {}
+
+  v8::Local<v8::Value> Deserialize() {
+    v8::EscapableHandleScope scope(isolate_);
+    context_ = isolate_->GetCurrentContext();
+
+    uint8_t tag = 0U;
+    v8::Local<v8::Value> value;
+    if (!ReadByte(&tag) || tag != kCompactFormatTag ||
+        !ReadValue(0U).ToLocal(&value) || !data_.empty()) {
+      return v8::Null(isolate_);
+    }
+    return scope.Escape(value);
+  }
+
+ private:
+  v8::MaybeLocal<v8::Value> ReadValue(size_t depth) {
+    uint8_t tag = 0U;
+    if (!ReadByte(&tag))
+      return {};
+
+    switch (static_cast<CompactTag>(tag)) {
+      case CompactTag::kUndefined:
+        return v8::Undefined(isolate_);
+      case CompactTag::kNull:
+        return v8::Null(isolate_);
+      case CompactTag::kTrue:
+        return v8::True(isolate_);
+      case CompactTag::kFalse:
+        return v8::False(isolate_);
+      case CompactTag::kInt32: {
+        uint32_t zigzag = 0U;
+        if (!ReadVarint(&zigzag))
+          return {};
+        const auto number =
+            static_cast<int32_t>((zigzag >> 1U) ^ (0U - (zigzag & 1U)));
+        return v8::Integer::New(isolate_, number);
+      }
+      case CompactTag::kDouble: {
+        double number = 0.0;
+        if (data_.size() < sizeof(number))
+          return {};
+        base::byte_span_from_ref(number).copy_from(
+            data_.take_first(sizeof(number)));
+        return v8::Number::New(isolate_, number);
+      }
+      case CompactTag::kOneByteString:
+      case CompactTag::kTwoByteString: {
+        v8::Local<v8::String> string;
+        if (!ReadString(static_cast<CompactTag>(tag)).ToLocal(&string))
+          return {};
+        return string;
+      }
+      case CompactTag::kArray:
+        return depth < kMaxCompactDepth ? ReadArray(depth)
+                                        : v8::MaybeLocal<v8::Value>();
+      case CompactTag::kObject:
+        return depth < kMaxCompactDepth ? ReadObject(depth)
+                                        : v8::MaybeLocal<v8::Value>();
+    }
+    return {};
+  }
+
+  v8::MaybeLocal<v8::String> ReadString(CompactTag tag) {
+    uint32_t length = 0U;
+    if (!ReadVarint(&length) ||
+        length > static_cast<uint32_t>(v8::String::kMaxLength)) {
+      return {};
+    }
+
+    if (tag == CompactTag::kOneByteString) {
+      if (data_.size() < length)
+        return {};
+      const auto chars = data_.take_first(length);
+      return v8::String::NewFromOneByte(isolate_, chars.data(),
+                                        v8::NewStringType::kNormal,
+                                        static_cast<int>(length));
+    }
+
+    if (data_.size() / sizeof(char16_t) < length)
+      return {};
+    // The bytes aren't necessarily aligned for char16_t.
+    std::u16string chars(length, u'\0');
+    base::as_writable_byte_span(chars).copy_from(
+        data_.take_first(length * sizeof(char16_t)));
+    return v8::String::NewFromTwoByte(
+        isolate_, reinterpret_cast<const uint16_t*>(chars.data()),
+        v8::NewStringType::kNormal, static_cast<int>(length));
+  }
+
+  v8::MaybeLocal<v8::Value> ReadArray(size_t depth) {
+    uint32_t length = 0U;
+    // Every element takes at least one byte.
+    if (!ReadVarint(&length) || length > data_.size())
+      return {};
+
+    v8::LocalVector<v8::Value> elements(isolate_);
+    elements.reserve(length);
+    for (uint32_t i = 0U; i < length; ++i) {
+      v8::Local<v8::Value> element;
+      if (!ReadValue(depth + 1U).ToLocal(&element))
+        return {};
+      elements.push_back(element);
+    }
+    return v8::Array::New(isolate_, elements.data(), elements.size());
+  }
+
+  v8::MaybeLocal<v8::Value> ReadObject(size_t depth) {
+    uint32_t length = 0U;
+    // Every property takes at least three bytes.
+    if (!ReadVarint(&length) || length > data_.size() / 3U)
+      return {};
+
+    v8::Local<v8::Object> object = v8::Object::New(isolate_);
+    for (uint32_t i = 0U; i < length; ++i) {
+      uint8_t tag = 0U;
+      v8::Local<v8::String> key;
+      v8::Local<v8::Value> property;
+      if (!ReadByte(&tag) ||
+          (tag != static_cast<uint8_t>(CompactTag::kOneByteString) &&
+           tag != static_cast<uint8_t>(CompactTag::kTwoByteString)) ||
+          !ReadString(static_cast<CompactTag>(tag)).ToLocal(&key) ||
+          !ReadValue(depth + 1U).ToLocal(&property) ||
+          !object->CreateDataProperty(context_, key, property)
+               .FromMaybe(false)) {
+        return {};
+      }
+    }
+    return object;
+  }
+
+  bool ReadByte(uint8_t* value) {
+    if (data_.empty())
+      return false;
+    *value = data_.take_first_elem();
+    return true;
+  }
+
+  bool ReadVarint(uint32_t* value) {
+    uint32_t result = 0U;
+    for (uint32_t shift = 0U; shift < 35U; shift += 7U) {
+      uint8_t byte = 0U;
+      if (!ReadByte(&byte))
+        return false;
+      result |= static_cast<uint32_t>(byte & 0x7FU) << shift;
+      if (!(byte & 0x80U)) {
+        *value = result;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  raw_ptr<v8::Isolate> isolate_;
+  v8::Local<v8::Context> context_;
+  base::span<const uint8_t> data_;
+};
+
+bool IsCompactFormat(base::span<const uint8_t> data) {
+  return !data.empty() && data.front() == kCompactFormatTag;
+}
+
 }  // namespace
 
 class V8Serializer : public v8::ValueSerializer::Delegate {
@@ -123,8 +550,6 @@ class V8Deserializer : public v8::ValueDeserializer::Delegate {
   V8Deserializer(v8::Isolate* isolate, base::span<const uint8_t> data)
       : isolate_(isolate),
         deserializer_(isolate, data.data(), data.size(), this) {}
-  V8Deserializer(v8::Isolate* isolate, const blink::CloneableMessage& message)
-      : V8Deserializer(isolate, message.encoded_message) {}
 
   v8::Local<v8::Value> Deserialize() {
     v8::EscapableHandleScope scope(isolate_);
@@ -230,13 +655,41 @@ bool SerializeV8Value(v8::Isolate* isolate,
   return V8Serializer(isolate).Serialize(value, out);
 }
 
+bool SerializeV8ValueForIPC(v8::Isolate* isolate,
+                            v8::Local<v8::Value> value,
+                            blink::CloneableMessage* out) {
+  std::optional<std::vector<uint8_t>> data;
+  {
+    v8::MicrotasksScope microtasks_scope(
+        isolate->GetCurrentContext(), v8::MicrotasksScope::kDoNotRunMicrotasks);
+    v8::TryCatch try_catch(isolate);
+    data = CompactSerializer(isolate).Serialize(value);
+    // The compact path doesn't run JS, but nothing should be sent twice if
+    // something threw anyway.
+    if (try_catch.HasCaught()) {
+      try_catch.ReThrow();
+      return false;
+    }
+  }
+  if (!data)
+    return SerializeV8Value(isolate, value, out);
+
+  out->owned_encoded_message = std::move(*data);
+  out->encoded_message = out->owned_encoded_message;
+  out->sender_agent_cluster_id =
+      blink::WebMessagePort::GetEmbedderAgentClusterID();
+  return true;
+}
+
 v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
                                         const blink::CloneableMessage& in) {
-  return V8Deserializer(isolate, in).Deserialize();
+  return DeserializeV8Value(isolate, in.encoded_message);
 }
 
 v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
                                         base::span<const uint8_t> data) {
+  if (IsCompactFormat(data))
+    return CompactDeserializer(isolate, data).Deserialize();
   return V8Deserializer(isolate, data).Deserialize();
 }
 
@@ -25,6 +25,13 @@ namespace electron {
 bool SerializeV8Value(v8::Isolate* isolate,
                       v8::Local<v8::Value> value,
                       blink::CloneableMessage* out);
+// Like SerializeV8Value, but values made only of primitives, arrays and plain
+// objects are written in a compact encoding that skips v8::ValueSerializer.
+// Only DeserializeV8Value can read it, so this must not be used for messages
+// that Blink deserializes, such as the ones posted to MessagePorts.
+bool SerializeV8ValueForIPC(v8::Isolate* isolate,
+                            v8::Local<v8::Value> value,
+                            blink::CloneableMessage* out);
 v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
                                         const blink::CloneableMessage& in);
 v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
@@ -0,0 +1,178 @@
+// Copyright (c) 2026 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/renderer/api/context_bridge/proxy_cache.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/check.h"
+#include "v8/include/v8-context.h"
+#include "v8/include/v8-function.h"
+#include "v8/include/v8-isolate.h"
+#include "v8/include/v8-local-handle.h"
+
+namespace electron::api::context_bridge {
+
+namespace {
+
+// Each renderer thread runs a single isolate.
+constinit thread_local ProxyCache* current_cache = nullptr;
+
+// Dead entries are swept once a context pair holds this many entries, and
+// again every time it doubles from what survived the previous sweep.
+constexpr size_t kMinSweepThreshold = 64U;
+
+// Proxies are bound to their receiver, so a function reached through a fresh
+// object on every call (e.g. an API returning a new result object each time)
+// never hits. Only the proxies for this many receivers of a function are
+// kept; older ones are evicted first.
+constexpr size_t kMaxReceiversPerFunction = 4U;
+
+}  // namespace
+
+// static
+ProxyCache* ProxyCache::Get(v8::Isolate* isolate) {
+  if (current_cache)
+    return current_cache->isolate_ == isolate ? current_cache : nullptr;
+
+  gin::PerIsolateData* per_isolate_data = gin::PerIsolateData::From(isolate);
+  if (!per_isolate_data)
+    return nullptr;
+
+  current_cache = new ProxyCache(isolate, per_isolate_data);
+  return current_cache;
+}
+
+// static
+void ProxyCache::ReleaseContext(v8::Isolate* isolate,
+                                v8::Local<v8::Context> context) {
+  ProxyCache* cache = current_cache;
+  if (!cache || cache->isolate_ != isolate)
+    return;
+
+  std::erase_if(cache->context_pairs_, [&](const auto& pair) {
+    return pair->source == context || pair->destination == context;
+  });
+}
+
+ProxyCache::ProxyCache(v8::Isolate* isolate,
+                       gin::PerIsolateData* per_isolate_data)
+    : isolate_{isolate}, per_isolate_data_{per_isolate_data} {
+  per_isolate_data_->AddDisposeObserver(this);
+}
+
+ProxyCache::~ProxyCache() {
+  per_isolate_data_->RemoveDisposeObserver(this);
+  DCHECK_EQ(current_cache, this);
+  current_cache = nullptr;
+}
+
+v8::MaybeLocal<v8::Value> ProxyCache::GetProxy(
+    v8::Local<v8::Context> source_context,
+    v8::Local<v8::Context> destination_context,
+    v8::Local<v8::Function> func,
+    v8::Local<v8::Value> receiver,
+    bool support_dynamic_properties) const {
+  const ContextPair* pair =
+      FindContextPair(source_context, destination_context);
+  if (!pair)
+    return {};
+
+  const auto iter = pair->entries.find(func->GetIdentityHash());
+  if (iter == pair->entries.end())
+    return {};
+
+  for (const Entry& entry : iter->second) {
+    if (entry.func == func && entry.receiver == receiver &&
+        entry.support_dynamic_properties == support_dynamic_properties &&
+        !entry.proxy.IsEmpty()) {
+      return entry.proxy.Get(isolate_);
+    }
+  }
+  return {};
+}
+
+void ProxyCache::CacheProxy(v8::Local<v8::Context> source_context,
+                            v8::Local<v8::Context> destination_context,
+                            v8::Local<v8::Function> func,
+                            v8::Local<v8::Value> receiver,
+                            bool support_dynamic_properties,
+                            v8::Local<v8::Value> proxy) {
+  // Weak handles can only be made to objects.
+  if (!receiver->IsObject() || !proxy->IsObject())
+    return;
+
+  ContextPair* pair = FindContextPair(source_context, destination_context);
+  if (!pair) {
+    std::erase_if(context_pairs_, [](const auto& context_pair) {
+      return context_pair->source.IsEmpty() ||
+             context_pair->destination.IsEmpty();
+    });
+    auto new_pair = std::make_unique<ContextPair>();
+    new_pair->source.Reset(isolate_, source_context);
+    new_pair->source.SetWeak();
+    new_pair->destination.Reset(isolate_, destination_context);
+    new_pair->destination.SetWeak();
+    new_pair->sweep_threshold = kMinSweepThreshold;
+    pair = context_pairs_.emplace_back(std::move(new_pair)).get();
+  }
+
+  Entry entry;
+  entry.func.Reset(isolate_, func);
+  entry.func.SetWeak();
+  entry.receiver.Reset(isolate_, receiver);
+  entry.receiver.SetWeak();
+  entry.proxy.Reset(isolate_, proxy);
+  entry.proxy.SetWeak();
+  entry.support_dynamic_properties = support_dynamic_properties;
+
+  // Entries are appended, so the first ones found for |func| are the oldest.
+  std::vector<Entry>& entries = pair->entries[func->GetIdentityHash()];
+  const auto for_func = [&](const Entry& other) { return other.func == func; };
+  if (static_cast<size_t>(std::ranges::count_if(entries, for_func)) >=
+      kMaxReceiversPerFunction) {
+    entries.erase(std::ranges::find_if(entries, for_func));
+    --pair->size;
+  }
+  entries.push_back(std::move(entry));
+
+  if (++pair->size >= pair->sweep_threshold)
+    Sweep(*pair);
+}
+
+ProxyCache::ContextPair* ProxyCache::FindContextPair(
+    v8::Local<v8::Context> source_context,
+    v8::Local<v8::Context> destination_context) const {
+  const auto iter = std::ranges::find_if(context_pairs_, [&](const auto& pair) {
+    return pair->source == source_context &&
+           pair->destination == destination_context;
+  });
+  return iter == context_pairs_.end() ? nullptr : iter->get();
+}
+
+void ProxyCache::Sweep(ContextPair& pair) {
+  pair.size = 0U;
+  for (auto& [hash, entries] : pair.entries) {
+    std::erase_if(entries, [](const Entry& entry) {
+      return entry.func.IsEmpty() || entry.receiver.IsEmpty() ||
+             entry.proxy.IsEmpty();
+    });
+    pair.size += entries.size();
+  }
+  absl::erase_if(pair.entries,
+                 [](const auto& bucket) { return bucket.second.empty(); });
+  pair.sweep_threshold = std::max(kMinSweepThreshold, pair.size * 2U);
+}
+
+void ProxyCache::OnBeforeDispose(v8::Isolate* isolate) {
+  // The handles have to be reset while the isolate is still alive.
+  context_pairs_.clear();
+}
+
+void ProxyCache::OnDisposed() {
+  delete this;
+}
+
+}  // namespace electron::api::context_bridge
@@ -0,0 +1,99 @@
+// Copyright (c) 2026 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_RENDERER_API_CONTEXT_BRIDGE_PROXY_CACHE_H_
+#define ELECTRON_SHELL_RENDERER_API_CONTEXT_BRIDGE_PROXY_CACHE_H_
+
+#include <memory>
+#include <vector>
+
+#include "base/memory/raw_ptr.h"
+#include "gin/per_isolate_data.h"
+#include "third_party/abseil-cpp/absl/container/flat_hash_map.h"
+#include "v8/include/v8-forward.h"
+#include "v8/include/v8-persistent-handle.h"
+
+namespace electron::api::context_bridge {
+
+/**
+ * Proxy functions that outlive a single PassValueToOtherContext call, so that
+ * a function passed over the bridge repeatedly keeps one proxy instead of
+ * getting a new one every time.
+ *
+ * Entries are kept per pair of source and destination contexts and only hold
+ * weak references, so they never keep a function, its proxy or a context
+ * alive. All entries of a context are dropped when it is released. Since a
+ * proxy is bound to its receiver, only a few receivers are kept per function,
+ * so functions called on a fresh object every time don't grow the cache.
+ *
+ * Other objects are not cached here: they are copied rather than proxied, and
+ * every call has to see their current contents.
+ */
+class ProxyCache final : private gin::PerIsolateData::DisposeObserver {
+ public:
+  // Returns the cache for |isolate|, creating it if needed. Returns nullptr
+  // when the isolate has no gin::PerIsolateData to tie the cache's lifetime to.
+  static ProxyCache* Get(v8::Isolate* isolate);
+
+  // Drops every entry whose source or destination is |context|.
+  static void ReleaseContext(v8::Isolate* isolate,
+                             v8::Local<v8::Context> context);
+
+  // disable copy
+  ProxyCache(const ProxyCache&) = delete;
+  ProxyCache& operator=(const ProxyCache&) = delete;
+
+  v8::MaybeLocal<v8::Value> GetProxy(v8::Local<v8::Context> source_context,
+                                     v8::Local<v8::Context> destination_context,
+                                     v8::Local<v8::Function> func,
+                                     v8::Local<v8::Value> receiver,
+                                     bool support_dynamic_properties) const;
+  void CacheProxy(v8::Local<v8::Context> source_context,
+                  v8::Local<v8::Context> destination_context,
+                  v8::Local<v8::Function> func,
+                  v8::Local<v8::Value> receiver,
+                  bool support_dynamic_properties,
+                  v8::Local<v8::Value> proxy);
+
+ private:
+  struct Entry {
+    v8::Global<v8::Function> func;
+    v8::Global<v8::Value> receiver;
+    v8::Global<v8::Value> proxy;
+    bool support_dynamic_properties = false;
+  };
+
+  struct ContextPair {
+    v8::Global<v8::Context> source;
+    v8::Global<v8::Context> destination;
+    // identity hash of func ==> entries
+    absl::flat_hash_map<int, std::vector<Entry>> entries;
+    size_t size = 0U;
+    size_t sweep_threshold = 0U;
+  };
+
+  ProxyCache(v8::Isolate* isolate, gin::PerIsolateData* per_isolate_data);
+  ~ProxyCache() override;
+
+  ContextPair* FindContextPair(
+      v8::Local<v8::Context> source_context,
+      v8::Local<v8::Context> destination_context) const;
+
+  // Drops the entries whose function or proxy has been garbage collected.
+  void Sweep(ContextPair& pair);
+
+  // gin::PerIsolateData::DisposeObserver
+  void OnBeforeDispose(v8::Isolate* isolate) override;
+  void OnBeforeMicrotasksRunnerDispose(v8::Isolate* isolate) override {}
+  void OnDisposed() override;
+
+  const raw_ptr<v8::Isolate> isolate_;
+  const raw_ptr<gin::PerIsolateData> per_isolate_data_;
+
+  std::vector<std::unique_ptr<ContextPair>> context_pairs_;
+};
+
+}  // namespace electron::api::context_bridge
+
+#endif  // ELECTRON_SHELL_RENDERER_API_CONTEXT_BRIDGE_PROXY_CACHE_H_
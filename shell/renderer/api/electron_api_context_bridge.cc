@@ -10,6 +10,8 @@
 #include <utility>
 #include <vector>
 
+#include "base/compiler_specific.h"
+#include "base/containers/span.h"
 #include "base/feature_list.h"
 #include "base/json/json_writer.h"
 #include "base/trace_event/trace_event.h"
@@ -23,6 +25,7 @@
 #include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/world_ids.h"
+#include "shell/renderer/api/context_bridge/proxy_cache.h"
 #include "shell/renderer/preload_realm_context.h"
 #include "third_party/abseil-cpp/absl/strings/str_format.h"
 #include "third_party/blink/public/web/web_blob.h"
@@ -55,6 +58,12 @@ constexpr std::string_view kSupportsDynamicPropertiesPrivateKey =
     "electron_contextBridge_supportsDynamicProperties";
 constexpr std::string_view kOriginalFunctionPrivateKey =
     "electron_contextBridge_original_fn";
+constexpr std::string_view kTransferPrivateKey =
+    "electron_contextBridge_transfer";
+constexpr std::string_view kLazyPropertyValuePrivateKey =
+    "electron_contextBridge_lazy_value";
+constexpr std::string_view kLazyPropertyReceiverPrivateKey =
+    "electron_contextBridge_lazy_receiver";
 
 static int kMaxRecursion = 1000;
 
@@ -134,6 +143,108 @@ v8::MaybeLocal<v8::Value> GetPrivate(v8::Isolate* const isolate,
       context, v8::Private::ForApi(isolate, gin::StringToV8(isolate, key)));
 }
 
+// Typed arrays that can be recreated over an ArrayBuffer in another world.
+#define ELECTRON_BRIDGE_TYPED_ARRAYS(V) \
+  V(Uint8Array)                         \
+  V(Uint8ClampedArray)                  \
+  V(Int8Array)                          \
+  V(Uint16Array)                        \
+  V(Int16Array)                         \
+  V(Uint32Array)                        \
+  V(Int32Array)                         \
+  V(Float32Array)                       \
+  V(Float64Array)                       \
+  V(BigInt64Array)                      \
+  V(BigUint64Array)
+
+bool IsSupportedArrayBufferView(v8::Local<v8::ArrayBufferView> view) {
+#define V(Type)         \
+  if (view->Is##Type()) \
+    return true;
+  ELECTRON_BRIDGE_TYPED_ARRAYS(V)
+#undef V
+  return view->IsDataView();
+}
+
+// Creates a view of the same type as |view| over |buffer| in the current
+// context. |length| is in elements, or in bytes for a DataView.
+v8::Local<v8::Value> CreateArrayBufferView(v8::Local<v8::ArrayBufferView> view,
+                                           v8::Local<v8::ArrayBuffer> buffer,
+                                           size_t byte_offset,
+                                           size_t length) {
+#define V(Type)         \
+  if (view->Is##Type()) \
+    return v8::Type::New(buffer, byte_offset, length);
+  ELECTRON_BRIDGE_TYPED_ARRAYS(V)
+#undef V
+  return v8::DataView::New(buffer, byte_offset, length);
+}
+
+// ArrayBuffers and their views are passed between worlds of the same isolate
+// without a serializer round-trip. Their contents are copied directly, or,
+// for buffers marked with contextBridge.transfer(), the backing store is
+// moved to the destination world and the source buffer is detached. Returns
+// an empty handle, without throwing, for values that must be serialized.
+v8::MaybeLocal<v8::Value> PassArrayBufferToOtherContext(
+    v8::Isolate* const isolate,
+    v8::Local<v8::Context> source_context,
+    v8::Local<v8::Context> destination_context,
+    v8::Local<v8::Value> value) {
+  v8::Local<v8::ArrayBufferView> view;
+  v8::Local<v8::ArrayBuffer> buffer;
+  if (value->IsArrayBufferView()) {
+    view = value.As<v8::ArrayBufferView>();
+    if (!IsSupportedArrayBufferView(view))
+      return {};
+    buffer = view->Buffer();
+  } else {
+    buffer = value.As<v8::ArrayBuffer>();
+  }
+
+  // Resizable buffers keep using the serializer.
+  if (buffer->IsResizableByUserJavaScript())
+    return {};
+
+  // Read the layout up front, since detaching the buffer resets it.
+  const size_t byte_offset = view.IsEmpty() ? 0U : view->ByteOffset();
+  const size_t byte_length =
+      view.IsEmpty() ? buffer->ByteLength() : view->ByteLength();
+  const size_t length = view.IsEmpty() || view->IsDataView()
+                            ? byte_length
+                            : view.As<v8::TypedArray>()->Length();
+
+  v8::Local<v8::Value> transfer;
+  if (GetPrivate(isolate, source_context, buffer, kTransferPrivateKey)
+          .ToLocal(&transfer) &&
+      transfer->IsTrue() && buffer->IsDetachable()) {
+    std::shared_ptr<v8::BackingStore> backing_store = buffer->GetBackingStore();
+    v8::TryCatch try_catch(isolate);
+    if (IsTrue(buffer->Detach(v8::Local<v8::Value>()))) {
+      v8::Context::Scope destination_scope(destination_context);
+      auto transferred =
+          v8::ArrayBuffer::New(isolate, std::move(backing_store));
+      if (view.IsEmpty())
+        return transferred;
+      return CreateArrayBufferView(view, transferred, byte_offset, length);
+    }
+    // Buffers with a detach key can't be transferred; copy them instead.
+  }
+
+  // Only the viewed bytes are copied, so the copy's view starts at offset 0.
+  v8::Context::Scope destination_scope(destination_context);
+  auto copy = v8::ArrayBuffer::New(isolate, byte_length);
+  if (byte_length > 0U) {
+    const auto source = UNSAFE_BUFFERS(
+        base::span(static_cast<const uint8_t*>(buffer->Data()) + byte_offset,
+                   byte_length));
+    UNSAFE_BUFFERS(base::span(static_cast<uint8_t*>(copy->Data()), byte_length))
+        .copy_from(source);
+  }
+  if (view.IsEmpty())
+    return copy;
+  return CreateArrayBufferView(view, copy, 0U, length);
+}
+
 }  // namespace
 
 // Forward declare methods
@@ -215,6 +326,17 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContextInner(
         return v8::MaybeLocal<v8::Value>(proxy_func);
       }
 
+      // Reuse the proxy made by an earlier call for the same function.
+      auto* proxy_cache = context_bridge::ProxyCache::Get(destination_isolate);
+      if (proxy_cache &&
+          proxy_cache
+              ->GetProxy(source_context, destination_context, func,
+                         parent_value, support_dynamic_properties)
+              .ToLocal(&proxy_func)) {
+        object_cache->CacheProxiedObject(value, proxy_func);
+        return v8::MaybeLocal<v8::Value>(proxy_func);
+      }
+
       v8::Local<v8::Object> state = v8::Object::New(destination_isolate);
       SetPrivate(destination_isolate, destination_context, state,
                  kProxyFunctionPrivateKey, func);
@@ -232,6 +354,11 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContextInner(
                  proxy_func.As<v8::Object>(), kOriginalFunctionPrivateKey,
                  func);
       object_cache->CacheProxiedObject(value, proxy_func);
+      if (proxy_cache) {
+        proxy_cache->CacheProxy(source_context, destination_context, func,
+                                parent_value, support_dynamic_properties,
+                                proxy_func);
+      }
       return v8::MaybeLocal<v8::Value>(proxy_func);
     }
   }
@@ -443,6 +570,17 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContextInner(
     return v8::MaybeLocal<v8::Value>(passed_value.ToLocalChecked());
   }
 
+  if ((value->IsArrayBuffer() || value->IsArrayBufferView()) &&
+      source_isolate == destination_isolate) {
+    v8::Local<v8::Value> passed_value;
+    if (PassArrayBufferToOtherContext(source_isolate, source_context,
+                                      destination_context, value)
+            .ToLocal(&passed_value)) {
+      object_cache->CacheProxiedObject(value, passed_value);
+      return v8::MaybeLocal<v8::Value>(passed_value);
+    }
+  }
+
   // Serializable objects
   blink::CloneableMessage ret;
   {
@@ -734,12 +872,142 @@ v8::MaybeLocal<v8::Object> CreateProxyForAPI(
 
 namespace {
 
+void LazyPropertyGetter(v8::Local<v8::Name> property,
+                        const v8::PropertyCallbackInfo<v8::Value>& info);
+
+// Proxies |value| into |destination_context| one level at a time. Nested
+// plain objects and arrays of a plain object become lazy data properties that
+// are only proxied when they are first read, so that large trees cost only
+// as much as the parts the destination context actually uses.
+v8::MaybeLocal<v8::Value> PassValueToOtherContextLazily(
+    v8::Isolate* const isolate,
+    v8::Local<v8::Context> source_context,
+    v8::Local<v8::Context> destination_context,
+    v8::Local<v8::Value> value,
+    v8::Local<v8::Value> parent_value,
+    BridgeErrorTarget error_target) {
+  TRACE_EVENT0("electron", "ContextBridge::PassValueToOtherContextLazily");
+  const bool freeze =
+      !base::FeatureList::IsEnabled(features::kContextBridgeMutability);
+
+  if (!IsPlainObject(value)) {
+    v8::Local<v8::Value> proxy;
+    if (!PassValueToOtherContext(isolate, source_context, isolate,
+                                 destination_context, value, parent_value,
+                                 false, error_target)
+             .ToLocal(&proxy))
+      return {};
+    if (freeze && proxy->IsObject() && !proxy->IsTypedArray() &&
+        !DeepFreeze(proxy.As<v8::Object>(), destination_context))
+      return {};
+    return proxy;
+  }
+
+  gin_helper::Dictionary api{isolate, value.As<v8::Object>()};
+  v8::Local<v8::Array> keys;
+  if (!api.GetHandle()
+           ->GetOwnPropertyNames(
+               source_context,
+               static_cast<v8::PropertyFilter>(v8::ONLY_ENUMERABLE),
+               v8::KeyConversionMode::kConvertToString)
+           .ToLocal(&keys))
+    return {};
+
+  v8::Context::Scope destination_context_scope(destination_context);
+  v8::Local<v8::Object> proxy = v8::Object::New(isolate);
+  // DeepFreeze would read, and therefore proxy, every property, so frozen
+  // attributes are set up front instead.
+  const auto attributes = freeze ? static_cast<v8::PropertyAttribute>(
+                                       v8::ReadOnly | v8::DontDelete)
+                                 : v8::None;
+
+  uint32_t length = keys->Length();
+  for (uint32_t i = 0; i < length; i++) {
+    v8::Local<v8::Name> key =
+        keys->Get(destination_context, i).ToLocalChecked().As<v8::Name>();
+
+    v8::Local<v8::Value> property_value;
+    {
+      v8::Context::Scope source_context_scope(source_context);
+      if (!api.Get(key, &property_value))
+        continue;
+    }
+
+    if (IsPlainObject(property_value) || IsPlainArray(property_value)) {
+      v8::Local<v8::Object> state = v8::Object::New(isolate);
+      SetPrivate(isolate, destination_context, state,
+                 kLazyPropertyValuePrivateKey, property_value);
+      SetPrivate(isolate, destination_context, state,
+                 kLazyPropertyReceiverPrivateKey, value);
+      if (!IsTrue(proxy->SetLazyDataProperty(destination_context, key,
+                                             LazyPropertyGetter, state,
+                                             attributes)))
+        return {};
+      continue;
+    }
+
+    v8::Local<v8::Value> passed_value;
+    if (!PassValueToOtherContext(isolate, source_context, isolate,
+                                 destination_context, property_value, value,
+                                 false, error_target)
+             .ToLocal(&passed_value))
+      return {};
+    if (freeze && passed_value->IsObject() && !passed_value->IsTypedArray() &&
+        !DeepFreeze(passed_value.As<v8::Object>(), destination_context))
+      return {};
+    if (!IsTrue(proxy->DefineOwnProperty(destination_context, key,
+                                         passed_value, attributes)))
+      return {};
+  }
+
+  if (freeze &&
+      !IsTrue(proxy->SetIntegrityLevel(destination_context,
+                                       v8::IntegrityLevel::kSealed)))
+    return {};
+  return proxy;
+}
+
+void LazyPropertyGetter(v8::Local<v8::Name> property,
+                        const v8::PropertyCallbackInfo<v8::Value>& info) {
+  TRACE_EVENT0("electron", "ContextBridge::LazyPropertyGetter");
+  v8::Isolate* const isolate = info.GetIsolate();
+  CHECK(info.Data()->IsObject());
+  v8::Local<v8::Object> state = info.Data().As<v8::Object>();
+  v8::Local<v8::Context> destination_context =
+      state->GetCreationContextChecked(isolate);
+
+  v8::Local<v8::Value> value;
+  v8::Local<v8::Value> parent_value;
+  if (!GetPrivate(isolate, destination_context, state,
+                  kLazyPropertyValuePrivateKey)
+           .ToLocal(&value) ||
+      !GetPrivate(isolate, destination_context, state,
+                  kLazyPropertyReceiverPrivateKey)
+           .ToLocal(&parent_value) ||
+      !value->IsObject())
+    return;
+
+  v8::Local<v8::Context> source_context =
+      value.As<v8::Object>()->GetCreationContextChecked(isolate);
+
+  // The property is read by the destination context, which is also the one
+  // that has to be able to catch any error.
+  v8::Local<v8::Value> proxy;
+  if (!PassValueToOtherContextLazily(isolate, source_context,
+                                     destination_context, value, parent_value,
+                                     BridgeErrorTarget::kDestination)
+           .ToLocal(&proxy))
+    return;
+  info.GetReturnValue().Set(proxy);
+}
+
 void ExposeAPI(v8::Isolate* isolate,
                v8::Local<v8::Context> source_context,
                v8::Isolate* target_isolate,
                v8::Local<v8::Context> target_context,
                const std::string& key,
-               v8::Local<v8::Value> api) {
+               v8::Local<v8::Value> api,
+               bool lazy) {
   DCHECK(!target_context.IsEmpty());
   v8::Context::Scope target_context_scope(target_context);
   gin_helper::Dictionary global(target_isolate, target_context->Global());
@@ -751,6 +1019,21 @@ void ExposeAPI(v8::Isolate* isolate,
     return;
   }
 
+  if (lazy) {
+    DCHECK_EQ(isolate, target_isolate);
+    v8::Local<v8::Value> proxy;
+    if (!PassValueToOtherContextLazily(isolate, source_context, target_context,
+                                       api, source_context->Global(),
+                                       BridgeErrorTarget::kSource)
+             .ToLocal(&proxy))
+      return;
+    if (base::FeatureList::IsEnabled(features::kContextBridgeMutability))
+      global.Set(key, proxy);
+    else
+      global.SetReadOnlyNonConfigurable(key, proxy);
+    return;
+  }
+
   v8::MaybeLocal<v8::Value> maybe_proxy = PassValueToOtherContext(
       isolate, source_context, target_isolate, target_context, api,
       source_context->Global(), false, BridgeErrorTarget::kSource);
@@ -812,7 +1095,8 @@ v8::MaybeLocal<v8::Context> GetTargetContext(v8::Isolate* isolate,
 void ExposeAPIInWorld(v8::Isolate* isolate,
                       const int world_id,
                       const std::string& key,
-                      v8::Local<v8::Value> api) {
+                      v8::Local<v8::Value> api,
+                      bool lazy) {
   TRACE_EVENT2("electron", "ContextBridge::ExposeAPIInWorld", "key", key,
                "worldId", world_id);
   v8::Local<v8::Context> source_context = isolate->GetCurrentContext();
@@ -823,7 +1107,8 @@ void ExposeAPIInWorld(v8::Isolate* isolate,
   if (maybe_target_context.IsEmpty() || !target_isolate)
     return;
   v8::Local<v8::Context> target_context = maybe_target_context.ToLocalChecked();
-  ExposeAPI(isolate, source_context, target_isolate, target_context, key, api);
+  ExposeAPI(isolate, source_context, target_isolate, target_context, key, api,
+            lazy);
 }
 
 gin_helper::Dictionary TraceKeyPath(const gin_helper::Dictionary& start,
@@ -921,6 +1206,37 @@ bool OverrideGlobalPropertyFromIsolatedWorld(
   }
 }
 
+// Marks the ArrayBuffer behind |value| to be transferred, rather than copied,
+// whenever it crosses the bridge.
+v8::Local<v8::Value> MarkForTransfer(v8::Isolate* const isolate,
+                                     gin::Arguments* const args) {
+  v8::Local<v8::Value> value;
+  if (!args->GetNext(&value) ||
+      !(value->IsArrayBuffer() || value->IsArrayBufferView())) {
+    args->ThrowTypeError("Expected an ArrayBuffer or ArrayBufferView");
+    return v8::Undefined(isolate);
+  }
+
+  v8::Local<v8::ArrayBuffer> buffer;
+  if (value->IsArrayBufferView()) {
+    auto view = value.As<v8::ArrayBufferView>();
+    buffer = view->Buffer();
+    // Transferring detaches the whole buffer, which must not take other views
+    // of it (such as pooled Node.js Buffers) along.
+    if (view->ByteOffset() != 0 || view->ByteLength() != buffer->ByteLength()) {
+      args->ThrowTypeError(
+          "Only views covering their whole ArrayBuffer can be transferred");
+      return v8::Undefined(isolate);
+    }
+  } else {
+    buffer = value.As<v8::ArrayBuffer>();
+  }
+
+  SetPrivate(isolate, isolate->GetCurrentContext(), buffer, kTransferPrivateKey,
+             v8::True(isolate));
+  return value;
+}
+
 // Serialize script to be executed in the given world.
 v8::Local<v8::Value> ExecuteInWorld(v8::Isolate* const isolate,
                                     const int world_id,
@@ -1137,6 +1453,7 @@ void Initialize(v8::Local<v8::Object> exports,
   gin_helper::Dictionary dict{isolate, exports};
   dict.SetMethod("executeInWorld", &electron::api::ExecuteInWorld);
   dict.SetMethod("exposeAPIInWorld", &electron::api::ExposeAPIInWorld);
+  dict.SetMethod("transfer", &electron::api::MarkForTransfer);
   dict.SetMethod("_overrideGlobalValueFromIsolatedWorld",
                  &electron::api::OverrideGlobalValueFromIsolatedWorld);
   dict.SetMethod("_overrideGlobalPropertyFromIsolatedWorld",
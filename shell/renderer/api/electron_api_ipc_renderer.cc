@@ -3,7 +3,12 @@
 // found in the LICENSE file.
 
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "base/functional/bind.h"
+#include "base/memory/weak_ptr.h"
+#include "base/task/sequenced_task_runner.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_frame_observer.h"
 #include "content/public/renderer/worker_thread.h"
@@ -38,6 +43,10 @@ namespace {
 const char kIPCMethodCalledAfterContextReleasedError[] =
     "IPC method called after context was released";
 
+// Batched messages are flushed early once their serialized arguments reach
+// this size, so that a single batch never grows into an oversized message.
+constexpr size_t kMaxBatchedMessagesSize = 256 * 1024;
+
 RenderFrame* GetCurrentRenderFrame() {
   WebLocalFrame* frame = WebLocalFrame::FrameForCurrentContext();
   if (!frame)
@@ -73,12 +82,38 @@ class IPCBase : public gin_helper::DeprecatedWrappable<T> {
       return;
     }
     blink::CloneableMessage message;
-    if (!electron::SerializeV8Value(isolate, arguments, &message)) {
+    if (!electron::SerializeV8ValueForIPC(isolate, arguments, &message)) {
       return;
     }
+    FlushBatchedMessages();
     electron_ipc_remote_->Message(internal, channel, std::move(message));
   }
 
+  void SendBatchedMessage(v8::Isolate* isolate,
+                          gin_helper::ErrorThrower thrower,
+                          const std::string& channel,
+                          v8::Local<v8::Value> arguments) {
+    if (!electron_ipc_remote_) {
+      thrower.ThrowError(kIPCMethodCalledAfterContextReleasedError);
+      return;
+    }
+    blink::CloneableMessage message;
+    if (!electron::SerializeV8ValueForIPC(isolate, arguments, &message)) {
+      return;
+    }
+
+    batched_messages_size_ += message.encoded_message.size();
+    batched_messages_.push_back(
+        electron::mojom::BatchedMessage::New(channel, std::move(message)));
+    if (batched_messages_size_ >= kMaxBatchedMessagesSize) {
+      FlushBatchedMessages();
+    } else if (batched_messages_.size() == 1) {
+      base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+          FROM_HERE, base::BindOnce(&IPCBase::FlushBatchedMessages,
+                                    weak_factory_.GetWeakPtr()));
+    }
+  }
+
   v8::Local<v8::Promise> Invoke(v8::Isolate* isolate,
                                 gin_helper::ErrorThrower thrower,
                                 bool internal,
@@ -89,9 +124,10 @@ class IPCBase : public gin_helper::DeprecatedWrappable<T> {
       return {};
     }
     blink::CloneableMessage message;
-    if (!electron::SerializeV8Value(isolate, arguments, &message)) {
+    if (!electron::SerializeV8ValueForIPC(isolate, arguments, &message)) {
       return {};
     }
+    FlushBatchedMessages();
     gin_helper::Promise<blink::CloneableMessage> p(isolate);
     auto handle = p.GetHandle();
 
@@ -142,6 +178,7 @@ class IPCBase : public gin_helper::DeprecatedWrappable<T> {
     }
 
     transferable_message.ports = std::move(ports);
+    FlushBatchedMessages();
     electron_ipc_remote_->ReceivePostMessage(channel,
                                              std::move(transferable_message));
   }
@@ -155,9 +192,10 @@ class IPCBase : public gin_helper::DeprecatedWrappable<T> {
       return;
     }
     blink::CloneableMessage message;
-    if (!electron::SerializeV8Value(isolate, arguments, &message)) {
+    if (!electron::SerializeV8ValueForIPC(isolate, arguments, &message)) {
       return;
     }
+    FlushBatchedMessages();
     electron_ipc_remote_->MessageHost(channel, std::move(message));
   }
 
@@ -171,10 +209,11 @@ class IPCBase : public gin_helper::DeprecatedWrappable<T> {
       return {};
     }
     blink::CloneableMessage message;
-    if (!electron::SerializeV8Value(isolate, arguments, &message)) {
+    if (!electron::SerializeV8ValueForIPC(isolate, arguments, &message)) {
       return {};
     }
 
+    FlushBatchedMessages();
     blink::CloneableMessage result;
     electron_ipc_remote_->MessageSync(internal, channel, std::move(message),
                                       &result);
@@ -186,6 +225,7 @@ class IPCBase : public gin_helper::DeprecatedWrappable<T> {
       v8::Isolate* isolate) override {
     return gin_helper::DeprecatedWrappable<T>::GetObjectTemplateBuilder(isolate)
         .SetMethod("send", &T::SendMessage)
+        .SetMethod("sendBatched", &T::SendBatchedMessage)
         .SetMethod("sendSync", &T::SendSync)
         .SetMethod("sendToHost", &T::SendToHost)
         .SetMethod("invoke", &T::Invoke)
@@ -193,7 +233,24 @@ class IPCBase : public gin_helper::DeprecatedWrappable<T> {
   }
 
  protected:
+  // Sends the messages queued by SendBatchedMessage, if any. Every other
+  // message is sent after flushing the queue so that ordering is preserved.
+  void FlushBatchedMessages() {
+    if (batched_messages_.empty())
+      return;
+    batched_messages_size_ = 0U;
+    auto messages = std::exchange(batched_messages_, {});
+    if (electron_ipc_remote_)
+      electron_ipc_remote_->MessageBatch(std::move(messages));
+  }
+
   mojo::AssociatedRemote<electron::mojom::ElectronApiIPC> electron_ipc_remote_;
+
+ private:
+  std::vector<electron::mojom::BatchedMessagePtr> batched_messages_;
+  size_t batched_messages_size_ = 0U;
+
+  base::WeakPtrFactory<IPCBase> weak_factory_{this};
 };
 
 class IPCRenderFrame : public IPCBase<IPCRenderFrame>,
@@ -225,6 +282,7 @@ class IPCRenderFrame : public IPCBase<IPCRenderFrame>,
                                 v8::Local<v8::Context> context,
                                 int32_t world_id) override {
     if (weak_context_.IsEmpty() || weak_context_.Get(isolate) == context) {
+      FlushBatchedMessages();
       OnDestruct();
     }
   }
@@ -254,7 +312,10 @@ class IPCServiceWorker : public IPCBase<IPCServiceWorker>,
         electron_ipc_remote_.BindNewEndpointAndPassReceiver());
   }
 
-  void WillStopCurrentWorkerThread() override { electron_ipc_remote_.reset(); }
+  void WillStopCurrentWorkerThread() override {
+    FlushBatchedMessages();
+    electron_ipc_remote_.reset();
+  }
 
   const char* GetTypeName() override { return "IPCServiceWorker"; }
 };
@@ -11,9 +11,11 @@
 #include "base/trace_event/trace_event.h"
 #include "gin/data_object_builder.h"
 #include "mojo/public/cpp/system/platform_handle.h"
+#include "shell/common/api/electron_api_shared_ring_buffer.h"
 #include "shell/common/electron_constants.h"
 #include "shell/common/gin_converters/blink_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
+#include "shell/common/gin_helper/handle.h"
 #include "shell/common/heap_snapshot.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
@@ -74,7 +76,29 @@ void ElectronApiServiceImpl::DidCreateDocumentElement() {
   }
 }
 
+void ElectronApiServiceImpl::WillReleaseScriptContext(
+    v8::Isolate* isolate,
+    v8::Local<v8::Context> context,
+    int world_id) {
+  v8::HandleScope handle_scope(isolate);
+  std::erase_if(shared_ring_buffers_, [&](const auto& ring) {
+    if (!ring)
+      return true;
+    v8::Local<v8::Object> wrapper;
+    if (ring->GetWrapper(isolate).ToLocal(&wrapper) &&
+        wrapper->GetCreationContextChecked(isolate) != context) {
+      return false;
+    }
+    ring->Shutdown();
+    return true;
+  });
+}
+
 void ElectronApiServiceImpl::OnDestruct() {
+  for (const auto& ring : shared_ring_buffers_) {
+    if (ring)
+      ring->Shutdown();
+  }
   delete this;
 }
 
@@ -129,6 +153,29 @@ void ElectronApiServiceImpl::ReceivePostMessage(
                            gin::ConvertToV8(isolate, args));
 }
 
+void ElectronApiServiceImpl::ReceiveSharedRingBuffer(
+    const std::string& channel,
+    mojom::SharedRingBufferEndpointPtr endpoint) {
+  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+  if (!frame)
+    return;
+
+  v8::Isolate* isolate = frame->GetAgentGroupScheduler()->Isolate();
+  v8::HandleScope handle_scope(isolate);
+
+  v8::Local<v8::Context> context = renderer_client_->GetContext(frame, isolate);
+  v8::Context::Scope context_scope(context);
+
+  auto ring = api::SharedRingBuffer::Create(isolate, std::move(endpoint));
+  if (ring.IsEmpty())
+    return;
+  std::erase_if(shared_ring_buffers_,
+                [](const auto& entry) { return !entry; });
+  shared_ring_buffers_.push_back(ring->GetWeakPtr());
+
+  ipc_native::EmitSharedRingBuffer(isolate, context, channel, ring.ToV8());
+}
+
 void ElectronApiServiceImpl::TakeHeapSnapshot(
     mojo::ScopedHandle file,
     TakeHeapSnapshotCallback callback) {
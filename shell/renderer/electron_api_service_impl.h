@@ -6,6 +6,7 @@
 #define ELECTRON_SHELL_RENDERER_ELECTRON_API_SERVICE_IMPL_H_
 
 #include <string>
+#include <vector>
 
 #include "base/memory/weak_ptr.h"
 #include "content/public/renderer/render_frame.h"
@@ -16,6 +17,10 @@
 
 namespace electron {
 
+namespace api {
+class SharedRingBuffer;
+}  // namespace api
+
 class RendererClientBase;
 
 class ElectronApiServiceImpl : public mojom::ElectronRenderer,
@@ -37,6 +42,9 @@ class ElectronApiServiceImpl : public mojom::ElectronRenderer,
                blink::CloneableMessage arguments) override;
   void ReceivePostMessage(const std::string& channel,
                           blink::TransferableMessage message) override;
+  void ReceiveSharedRingBuffer(
+      const std::string& channel,
+      mojom::SharedRingBufferEndpointPtr endpoint) override;
   void TakeHeapSnapshot(mojo::ScopedHandle file,
                         TakeHeapSnapshotCallback callback) override;
   void ProcessPendingMessages();
@@ -52,6 +60,9 @@ class ElectronApiServiceImpl : public mojom::ElectronRenderer,
  private:
   // content::RenderFrameObserver
   void DidCreateDocumentElement() override;
+  void WillReleaseScriptContext(v8::Isolate* isolate,
+                                v8::Local<v8::Context> context,
+                                int world_id) override;
   void OnDestruct() override;
 
   void OnConnectionError();
@@ -63,6 +74,10 @@ class ElectronApiServiceImpl : public mojom::ElectronRenderer,
   mojo::PendingReceiver<mojom::ElectronRenderer> pending_receiver_;
   mojo::Receiver<mojom::ElectronRenderer> receiver_{this};
 
+  // The SharedRingBuffers received by this frame. They are kept alive while
+  // open, so they are closed when their context is released.
+  std::vector<base::WeakPtr<api::SharedRingBuffer>> shared_ring_buffers_;
+
   raw_ptr<RendererClientBase> renderer_client_;
   base::WeakPtrFactory<ElectronApiServiceImpl> weak_factory_{this};
 };
@@ -81,4 +81,19 @@ void EmitIPCEvent(v8::Isolate* const isolate,
   InvokeIpcCallback(isolate, context, "onMessage", argv);
 }
 
+void EmitSharedRingBuffer(v8::Isolate* const isolate,
+                          const v8::Local<v8::Context>& context,
+                          const std::string& channel,
+                          v8::Local<v8::Value> ring) {
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(context);
+  v8::MicrotasksScope script_scope(isolate, context->GetMicrotaskQueue(),
+                                   v8::MicrotasksScope::kRunMicrotasks);
+
+  std::vector<v8::Local<v8::Value>> argv = {gin::ConvertToV8(isolate, channel),
+                                            ring};
+
+  InvokeIpcCallback(isolate, context, "onSharedRingBuffer", argv);
+}
+
 }  // namespace electron::ipc_native
@@ -18,6 +18,11 @@ void EmitIPCEvent(v8::Isolate* isolate,
                   std::vector<v8::Local<v8::Value>> ports,
                   v8::Local<v8::Value> args);
 
+void EmitSharedRingBuffer(v8::Isolate* isolate,
+                          const v8::Local<v8::Context>& context,
+                          const std::string& channel,
+                          v8::Local<v8::Value> ring);
+
 }  // namespace electron::ipc_native
 
 #endif  // ELECTRON_SHELL_RENDERER_ELECTRON_IPC_NATIVE_H_
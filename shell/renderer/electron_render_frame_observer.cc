@@ -14,6 +14,7 @@
 #include "shell/common/options_switches.h"
 #include "shell/common/web_contents_utility.mojom.h"
 #include "shell/common/world_ids.h"
+#include "shell/renderer/api/context_bridge/proxy_cache.h"
 #include "shell/renderer/renderer_client_base.h"
 #include "third_party/blink/public/common/associated_interfaces/associated_interface_provider.h"
 #include "third_party/blink/public/common/web_preferences/web_preferences.h"
@@ -145,6 +146,7 @@ void ElectronRenderFrameObserver::WillReleaseScriptContext(
     v8::Isolate* const isolate,
     v8::Local<v8::Context> context,
     int world_id) {
+  api::context_bridge::ProxyCache::ReleaseContext(isolate, context);
   if (ShouldNotifyClient(world_id))
     renderer_client_->WillReleaseScriptContext(isolate, context, render_frame_);
 }
@@ -39,7 +39,7 @@ ElectronRendererClient::ElectronRendererClient()
     : node_bindings_{NodeBindings::Create(
           NodeBindings::BrowserEnvironment::kRenderer)},
       electron_bindings_{
-          std::make_unique<ElectronBindings>(node_bindings_->uv_loop())} {}
+          std::make_unique<ElectronBindings>(node_bindings_.get())} {}
 
 ElectronRendererClient::~ElectronRendererClient() = default;
 
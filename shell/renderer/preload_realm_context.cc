@@ -11,6 +11,7 @@
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/node_util.h"
+#include "shell/renderer/api/context_bridge/proxy_cache.h"
 #include "shell/renderer/preload_utils.h"
 #include "shell/renderer/service_worker_data.h"
 #include "third_party/blink/renderer/bindings/core/v8/script_controller.h"  // nogncheck
@@ -117,6 +118,8 @@ class PreloadRealmLifetimeController
     realm_context()->SetAlignedPointerInEmbedderData(
         kElectronContextEmbedderDataIndex, nullptr,
         v8::kEmbedderDataTypeTagDefault);
+    api::context_bridge::ProxyCache::ReleaseContext(realm_isolate(),
+                                                    realm_context());
 
     // See ShadowRealmGlobalScope::ContextDestroyed
     shadow_realm_script_state_->DisposePerContextData();
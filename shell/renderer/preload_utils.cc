@@ -4,11 +4,19 @@
 
 #include "shell/renderer/preload_utils.h"
 
+#include <memory>
+
+#include "base/compiler_specific.h"
+#include "base/containers/span.h"
 #include "base/process/process.h"
 #include "base/strings/strcat.h"
+#include "gin/arguments.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/node_includes.h"
+#include "v8/include/v8-array-buffer.h"
 #include "v8/include/v8-context.h"
+#include "v8/include/v8-script.h"
+#include "v8/include/v8-typed-array.h"
 
 namespace electron::preload_utils {
 
@@ -29,6 +37,24 @@ v8::Local<v8::Object> GetBindingCache(v8::Isolate* isolate) {
   return cache->ToObject(context).ToLocalChecked();
 }
 
+v8::Local<v8::Uint8Array> CreateCodeCache(v8::Isolate* isolate,
+                                          v8::Local<v8::Script> script) {
+  std::unique_ptr<v8::ScriptCompiler::CachedData> cached_data{
+      v8::ScriptCompiler::CreateCodeCache(script->GetUnboundScript())};
+  if (!cached_data)
+    return {};
+
+  // The caller copies the cache to the browser process, so it can't be an
+  // external buffer.
+  const auto data = UNSAFE_BUFFERS(base::span(
+      cached_data->data, static_cast<size_t>(cached_data->length)));
+  auto buffer = v8::ArrayBuffer::New(isolate, data.size());
+  UNSAFE_BUFFERS(base::span(static_cast<uint8_t*>(buffer->Data()),
+                            data.size()))
+      .copy_from(data);
+  return v8::Uint8Array::New(buffer, 0, data.size());
+}
+
 }  // namespace
 
 // adapted from node.cc
@@ -59,13 +85,55 @@ v8::Local<v8::Value> GetBinding(v8::Isolate* isolate,
 }
 
 v8::Local<v8::Value> CreatePreloadScript(v8::Isolate* isolate,
-                                         v8::Local<v8::String> source) {
+                                         v8::Local<v8::String> source,
+                                         gin::Arguments* args) {
   auto context = isolate->GetCurrentContext();
-  auto maybe_script = v8::Script::Compile(context, source);
+
+  v8::Local<v8::Value> cached_data_value;
+  bool produce_cached_data = false;
+  args->GetNext(&cached_data_value);
+  args->GetNext(&produce_cached_data);
+
+  // The cache is only read during compilation, so it can point into the
+  // caller's buffer.
+  v8::ScriptCompiler::CachedData* cached_data = nullptr;
+  if (!cached_data_value.IsEmpty() &&
+      cached_data_value->IsArrayBufferView()) {
+    auto view = cached_data_value.As<v8::ArrayBufferView>();
+    const auto* data = static_cast<const uint8_t*>(view->Buffer()->Data());
+    cached_data = new v8::ScriptCompiler::CachedData(
+        UNSAFE_BUFFERS(data + view->ByteOffset()),
+        static_cast<int>(view->ByteLength()),
+        v8::ScriptCompiler::CachedData::BufferNotOwned);
+  }
+
+  // |script_source| takes ownership of |cached_data|.
+  v8::ScriptCompiler::Source script_source(source, cached_data);
   v8::Local<v8::Script> script;
-  if (!maybe_script.ToLocal(&script))
+  if (!v8::ScriptCompiler::Compile(context, &script_source,
+                                   cached_data
+                                       ? v8::ScriptCompiler::kConsumeCodeCache
+                                       : v8::ScriptCompiler::kNoCompileOptions)
+           .ToLocal(&script)) {
     return {};
-  return script->Run(context).ToLocalChecked();
+  }
+  const bool cache_consumed = cached_data && !cached_data->rejected;
+
+  auto ret = gin_helper::Dictionary::CreateEmpty(isolate);
+  ret.Set("result", script->Run(context).ToLocalChecked());
+  if (cached_data)
+    ret.Set("cacheRejected", !cache_consumed);
+
+  // Preloads are wrapped in a parenthesized function, which V8 compiles
+  // eagerly, so the cache covers their top-level code.
+  if (produce_cached_data && !cache_consumed) {
+    v8::Local<v8::Uint8Array> new_cached_data =
+        CreateCodeCache(isolate, script);
+    if (!new_cached_data.IsEmpty())
+      ret.Set("cachedData", new_cached_data);
+  }
+
+  return ret.GetHandle();
 }
 
 double Uptime() {
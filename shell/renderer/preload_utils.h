@@ -7,6 +7,10 @@
 
 #include "v8/include/v8-forward.h"
 
+namespace gin {
+class Arguments;
+}
+
 namespace gin_helper {
 class Arguments;
 }
@@ -16,8 +20,14 @@ namespace electron::preload_utils {
 v8::Local<v8::Value> GetBinding(v8::Isolate* isolate,
                                 v8::Local<v8::String> key);
 
+// Compiles and runs |source| in the current context. JS callers may pass a
+// code cache produced by an earlier call for the same source, and ask for a
+// new one to be produced when none was passed or V8 rejected it. Returns
+// { result, cachedData, cacheRejected }, where cacheRejected is only set when
+// a cache was passed.
 v8::Local<v8::Value> CreatePreloadScript(v8::Isolate* isolate,
-                                         v8::Local<v8::String> source);
+                                         v8::Local<v8::String> source,
+                                         gin::Arguments* args);
 
 double Uptime();
 
@@ -66,6 +66,12 @@ void ServiceWorkerData::ReceivePostMessage(const std::string& channel,
   NOTIMPLEMENTED();
 }
 
+void ServiceWorkerData::ReceiveSharedRingBuffer(
+    const std::string& channel,
+    mojom::SharedRingBufferEndpointPtr endpoint) {
+  NOTIMPLEMENTED();
+}
+
 void ServiceWorkerData::TakeHeapSnapshot(mojo::ScopedHandle file,
                                          TakeHeapSnapshotCallback callback) {
   NOTIMPLEMENTED();
@@ -45,6 +45,9 @@ class ServiceWorkerData : public mojom::ElectronRenderer {
                blink::CloneableMessage arguments) override;
   void ReceivePostMessage(const std::string& channel,
                           blink::TransferableMessage message) override;
+  void ReceiveSharedRingBuffer(
+      const std::string& channel,
+      mojom::SharedRingBufferEndpointPtr endpoint) override;
   void TakeHeapSnapshot(mojo::ScopedHandle file,
                         TakeHeapSnapshotCallback callback) override;
 
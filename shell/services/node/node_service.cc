@@ -94,7 +94,7 @@ NodeService::NodeService(
     : node_bindings_{NodeBindings::Create(
           NodeBindings::BrowserEnvironment::kUtility)},
       electron_bindings_{
-          std::make_unique<ElectronBindings>(node_bindings_->uv_loop())} {
+          std::make_unique<ElectronBindings>(node_bindings_.get())} {
   if (receiver.is_valid())
     receiver_.Bind(std::move(receiver));
 }
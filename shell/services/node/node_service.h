@@ -77,7 +77,7 @@ class NodeService : public node::mojom::NodeService {
 
   const std::unique_ptr<NodeBindings> node_bindings_;
 
-  // depends-on: node_bindings_'s uv_loop
+  // depends-on: node_bindings_
   const std::unique_ptr<ElectronBindings> electron_bindings_;
 
   // depends-on: node_bindings_'s uv_loop
@@ -1,4 +1,4 @@
-import { app, BrowserWindow, Menu, session, net as electronNet, WebContents, utilityProcess } from 'electron/main';
+import { app, BrowserWindow, ipcMain, Menu, session, net as electronNet, WebContents, utilityProcess } from 'electron/main';
 
 import { assert, expect } from 'chai';
 import * as semver from 'semver';
@@ -1596,6 +1596,83 @@ describe('app module', () => {
     });
   });
 
+  describe('getIpcMetrics() API', () => {
+    afterEach(async () => {
+      ipcMain.removeHandler('ipc-metrics');
+      await closeAllWindows();
+    });
+
+    it('counts the messages of each channel and direction', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w.loadURL('about:blank');
+      ipcMain.handle('ipc-metrics', () => 'reply');
+      app.resetIpcMetrics();
+
+      await w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        Promise.all([ipcRenderer.invoke('ipc-metrics', 'a'), ipcRenderer.invoke('ipc-metrics', 'b')])
+      }`);
+      w.webContents.send('ipc-metrics', 'c');
+
+      const metrics = app.getIpcMetrics().filter(m => m.channel === 'ipc-metrics');
+      const received = metrics.find(m => m.direction === 'received')!;
+      expect(received.count).to.equal(2);
+      expect(received.bytes).to.be.greaterThan(0);
+      expect(received.handlerTime).to.be.a('number').that.is.at.least(0);
+      expect(received.handlerTimeHistogram).to.have.lengthOf(5);
+      expect(received.handlerTimeHistogram!.reduce((a, b) => a + b)).to.equal(2);
+      expect(received.queueTime).to.be.a('number').that.is.at.least(0);
+      expect(received.maxQueueTime).to.be.a('number').that.is.at.least(0);
+
+      const sent = metrics.find(m => m.direction === 'sent')!;
+      expect(sent.count).to.equal(1);
+      expect(sent.bytes).to.be.greaterThan(0);
+      expect(sent).to.not.have.property('handlerTime');
+    });
+
+    it('is cleared by resetIpcMetrics()', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      w.webContents.send('ipc-metrics', 'hello');
+      expect(app.getIpcMetrics().some(m => m.channel === 'ipc-metrics')).to.be.true();
+
+      app.resetIpcMetrics();
+      expect(app.getIpcMetrics().some(m => m.channel === 'ipc-metrics')).to.be.false();
+    });
+  });
+
+  describe('getFrameBufferPoolMetrics() API', () => {
+    afterEach(closeAllWindows);
+
+    it('counts the frames painted by offscreen rendering', async () => {
+      const before = app.getFrameBufferPoolMetrics();
+      const w = new BrowserWindow({ show: false, webPreferences: { offscreen: true } });
+      const paint = once(w.webContents, 'paint');
+      w.loadURL('about:blank');
+      await paint;
+
+      const after = app.getFrameBufferPoolMetrics();
+      expect(after.hits + after.misses).to.be.greaterThan(before.hits + before.misses);
+      expect(after.freeBytes).to.be.at.least(0);
+    });
+
+    it('frees idle buffers once painting stops', async function () {
+      this.timeout(30000);
+      const w = new BrowserWindow({ show: false, webPreferences: { offscreen: true } });
+      const paint = once(w.webContents, 'paint');
+      w.loadURL('about:blank');
+      await paint;
+      w.destroy();
+
+      const v8Util = process._linkedBinding('electron_common_v8_util');
+      await waitUntil(() => {
+        v8Util.requestGarbageCollectionForTesting();
+        return app.getFrameBufferPoolMetrics().freeBuffers === 0;
+      }, { rate: 500, timeout: 20000 });
+      expect(app.getFrameBufferPoolMetrics().freeBytes).to.equal(0);
+    });
+  });
+
   describe('getGPUFeatureStatus() API', () => {
     it('returns the graphic features statuses', () => {
       const features = app.getGPUFeatureStatus();
@@ -3,7 +3,7 @@ import { app, BrowserWindow, BrowserView, dialog, ipcMain, OnBeforeSendHeadersLi
 import { expect } from 'chai';
 
 import * as childProcess from 'node:child_process';
-import { once } from 'node:events';
+import { on, once } from 'node:events';
 import * as fs from 'node:fs';
 import * as http from 'node:http';
 import { AddressInfo } from 'node:net';
@@ -3791,6 +3791,102 @@ describe('BrowserWindow module', () => {
         expect(test).to.equal('preload');
       });
 
+      describe('preload code caches', () => {
+        let ses: Electron.Session;
+        let cacheDir: string;
+        beforeEach(() => {
+          ses = session.fromPartition(`persist:${randomString(10)}`);
+          cacheDir = path.join(ses.storagePath!, 'Preload Code Cache', process.versions.v8);
+        });
+
+        const loadPreload = async () => {
+          const w = new BrowserWindow({
+            show: false,
+            webPreferences: {
+              sandbox: true,
+              preload,
+              contextIsolation: false,
+              session: ses
+            }
+          });
+          const codeCache = once(w.webContents, '-preload-code-cache');
+          w.loadFile(path.join(fixtures, 'api', 'preload.html'));
+          const [, test] = await once(ipcMain, 'answer');
+          expect(test).to.equal('preload');
+          const [filePath, result] = await codeCache;
+          expect(filePath).to.equal(preload);
+          w.destroy();
+          return result;
+        };
+
+        it('reuses a code cache for preload scripts', async () => {
+          // The first renderer has no cache to use, so it produces one.
+          expect(await loadPreload()).to.deep.equal({ consumed: false, produced: true });
+          await waitUntil(() => fs.existsSync(cacheDir) && fs.readdirSync(cacheDir).length > 0);
+          // The next one is handed that cache, and V8 accepts it.
+          expect(await loadPreload()).to.deep.equal({ consumed: true, produced: false });
+        });
+
+        it('evicts old caches and caches of other V8 versions', async () => {
+          const staleVersionDir = path.join(path.dirname(cacheDir), '0.0.0.0');
+          fs.mkdirSync(staleVersionDir, { recursive: true });
+          fs.writeFileSync(path.join(staleVersionDir, 'stale'), 'stale');
+          fs.mkdirSync(cacheDir, { recursive: true });
+          const longAgo = new Date(2000, 0, 1);
+          for (let i = 0; i < 300; i++) {
+            const file = path.join(cacheDir, `old-${i}`);
+            fs.writeFileSync(file, 'old');
+            fs.utimesSync(file, longAgo, longAgo);
+          }
+
+          // Writing the new cache trims the directory.
+          expect(await loadPreload()).to.deep.equal({ consumed: false, produced: true });
+          await waitUntil(() => !fs.existsSync(staleVersionDir) && fs.readdirSync(cacheDir).length <= 256);
+          expect(fs.readdirSync(cacheDir).filter(name => !name.startsWith('old-'))).to.have.lengthOf(1);
+        });
+
+        it('is cleared with the session\'s code caches', async () => {
+          expect(await loadPreload()).to.deep.equal({ consumed: false, produced: true });
+          await waitUntil(() => fs.existsSync(cacheDir) && fs.readdirSync(cacheDir).length > 0);
+          await ses.clearCodeCaches({});
+          expect(fs.existsSync(cacheDir)).to.be.false();
+          expect(await loadPreload()).to.deep.equal({ consumed: false, produced: true });
+        });
+
+        it('is cleared with the session\'s storage data', async () => {
+          expect(await loadPreload()).to.deep.equal({ consumed: false, produced: true });
+          await waitUntil(() => fs.existsSync(cacheDir) && fs.readdirSync(cacheDir).length > 0);
+          await ses.clearStorageData();
+          expect(fs.existsSync(cacheDir)).to.be.false();
+          expect(await loadPreload()).to.deep.equal({ consumed: false, produced: true });
+        });
+      });
+
+      it('picks up changes to a preload script', async () => {
+        const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-sandbox-preload-'));
+        defer(() => fs.rmSync(dir, { force: true, recursive: true }));
+        const changingPreload = path.join(dir, 'preload.js');
+        const writePreload = (answer: string, mtime: Date) => {
+          fs.writeFileSync(changingPreload, `require('electron').ipcRenderer.send('answer', '${answer}');`);
+          fs.utimesSync(changingPreload, mtime, mtime);
+        };
+
+        writePreload('first', new Date(2000, 0, 1));
+        const w = new BrowserWindow({
+          show: false,
+          webPreferences: {
+            sandbox: true,
+            preload: changingPreload
+          }
+        });
+        w.loadURL('about:blank');
+        expect((await once(ipcMain, 'answer'))[1]).to.equal('first');
+
+        writePreload('second', new Date(2001, 0, 1));
+        w.webContents.reload();
+        expect((await once(ipcMain, 'answer'))[1]).to.equal('second');
+      });
+
       it('exposes "loaded" event to preload script', async () => {
         const w = new BrowserWindow({
           show: false,
@@ -4749,6 +4845,79 @@ describe('BrowserWindow module', () => {
       w.loadFile(path.join(fixtures, 'api', 'frame-subscriber.html'));
     });
 
+    it('subscribes to planar frames of a given size', (done) => {
+      const w = new BrowserWindow({ show: false });
+      let called = false;
+      w.loadFile(path.join(fixtures, 'api', 'frame-subscriber.html'));
+      w.webContents.on('dom-ready', () => {
+        w.webContents.beginFrameSubscription({
+          pixelFormat: 'i420',
+          frameRate: 60,
+          size: { width: 320, height: 240 }
+        }, (image, rect, frame) => {
+          // This callback might be called twice.
+          if (called) return;
+          called = true;
+
+          try {
+            expect(image.isEmpty()).to.be.true('image is not empty');
+            expect(frame).to.be.an('object');
+            expect(frame!.pixelFormat).to.equal('i420');
+            expect(frame!.contentRect.width).to.be.at.most(320);
+            expect(frame!.contentRect.height).to.be.at.most(240);
+            expect(frame!.planes).to.have.lengthOf(3);
+            const [y, u, v] = frame!.planes;
+            expect(y.stride).to.be.at.least(frame!.codedSize.width);
+            expect(y.data).to.be.an.instanceOf(Buffer).with.lengthOf(y.stride * frame!.codedSize.height);
+            expect(u.data).to.have.lengthOf(u.stride * Math.ceil(frame!.codedSize.height / 2));
+            expect(v.data).to.have.lengthOf(v.stride * Math.ceil(frame!.codedSize.height / 2));
+            done();
+          } catch (e) {
+            done(e);
+          } finally {
+            w.webContents.endFrameSubscription();
+          }
+        });
+      });
+    });
+
+    it('subscribes to NV12 frames', (done) => {
+      const w = new BrowserWindow({ show: false });
+      let called = false;
+      w.loadFile(path.join(fixtures, 'api', 'frame-subscriber.html'));
+      w.webContents.on('dom-ready', () => {
+        w.webContents.beginFrameSubscription({ pixelFormat: 'nv12' }, (image, rect, frame) => {
+          // This callback might be called twice.
+          if (called) return;
+          called = true;
+
+          try {
+            expect(frame!.pixelFormat).to.equal('nv12');
+            expect(frame!.planes).to.have.lengthOf(2);
+            const [y, uv] = frame!.planes;
+            expect(y.data).to.have.lengthOf(y.stride * frame!.codedSize.height);
+            expect(uv.stride).to.equal(2 * Math.ceil(frame!.codedSize.width / 2));
+            expect(uv.data).to.have.lengthOf(uv.stride * Math.ceil(frame!.codedSize.height / 2));
+            done();
+          } catch (e) {
+            done(e);
+          } finally {
+            w.webContents.endFrameSubscription();
+          }
+        });
+      });
+    });
+
+    it('throws error when the options are invalid', () => {
+      const w = new BrowserWindow({ show: false });
+      expect(() => {
+        w.webContents.beginFrameSubscription({ pixelFormat: 'rgb565' as any }, () => {});
+      }).to.throw("'pixelFormat' must be 'argb', 'i420' or 'nv12'");
+      expect(() => {
+        w.webContents.beginFrameSubscription({ frameRate: 0 }, () => {});
+      }).to.throw("'frameRate' must be in the [1, 240] range");
+    });
+
     it('throws error when subscriber is not well defined', () => {
       const w = new BrowserWindow({ show: false });
       expect(() => {
@@ -6877,6 +7046,135 @@ describe('BrowserWindow module', () => {
     });
   });
 
+  describe('offscreen rendering with zero copy', () => {
+    let w: BrowserWindow;
+    beforeEach(function () {
+      w = new BrowserWindow({
+        width: 100,
+        height: 100,
+        show: false,
+        webPreferences: {
+          backgroundThrottling: false,
+          offscreen: {
+            zeroCopy: true
+          }
+        }
+      });
+    });
+    afterEach(closeAllWindows);
+
+    it('paints images that can be read', async () => {
+      const paint = once(w.webContents, 'paint') as Promise<[any, Electron.Rectangle, Electron.NativeImage]>;
+      w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+      const [, , data] = await paint;
+      expect(data.isEmpty()).to.be.false('data is empty');
+      const { width, height } = data.getSize();
+      expect(data.toBitmap()).to.have.lengthOf(width * height * 4);
+    });
+
+    // Only frames from the video capturer, which is used with hardware
+    // acceleration, are referenced instead of copied.
+    ifit(app.isHardwareAccelerationEnabled())('stops painting while too many images are kept alive', async function () {
+      this.timeout(60000);
+      const v8Util = process._linkedBinding('electron_common_v8_util');
+      const images: Electron.NativeImage[] = [];
+      w.webContents.on('paint', (event, dirty, image) => { images.push(image); });
+      w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+
+      // The page changes every 10ms, so painting only stops once the capturer
+      // has no frame left to capture into.
+      let previous = -1;
+      await waitUntil(() => {
+        const stalled = images.length > 0 && images.length === previous;
+        previous = images.length;
+        return stalled;
+      }, { rate: 1000, timeout: 20000 });
+
+      images.length = 0;
+      v8Util.requestGarbageCollectionForTesting();
+      await waitUntil(() => images.length >= 2, { timeout: 20000 });
+    });
+  });
+
+  describe('offscreen rendering with dirty rect only', () => {
+    let w: BrowserWindow;
+    beforeEach(function () {
+      w = new BrowserWindow({
+        width: 100,
+        height: 100,
+        show: false,
+        webPreferences: {
+          backgroundThrottling: false,
+          offscreen: {
+            dirtyRectOnly: true
+          }
+        }
+      });
+    });
+    afterEach(closeAllWindows);
+
+    it('paints images of the dirty rect size', async () => {
+      w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+      for await (const [, dirtyRect, image] of on(w.webContents, 'paint')) {
+        const { width, height } = dirtyRect as Electron.Rectangle;
+        expect((image as Electron.NativeImage).getSize()).to.deep.equal({ width, height });
+        if (width < w.getContentSize()[0]) break;
+      }
+    });
+  });
+
+  describe('offscreen rendering with frame pacing', () => {
+    let w: BrowserWindow;
+    beforeEach(function () {
+      w = new BrowserWindow({
+        width: 100,
+        height: 100,
+        show: false,
+        webPreferences: {
+          backgroundThrottling: false,
+          offscreen: {
+            framePacing: true
+          }
+        }
+      });
+    });
+    afterEach(closeAllWindows);
+
+    it('reports the timing of each frame', async () => {
+      const paint = once(w.webContents, 'paint') as Promise<[any, Electron.Rectangle, Electron.NativeImage]>;
+      w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+      const [{ timing }] = await paint;
+      expect(timing.beginFrameTime).to.be.at.most(timing.captureTime);
+      expect(timing.captureTime).to.be.at.most(timing.deliveryTime);
+      expect(timing.deliveryTime).to.be.closeTo(Date.now(), 1000);
+    });
+
+    it('holds back frames until a deferred frame is done', async () => {
+      const deferred = new Promise<() => void>(resolve => {
+        w.webContents.once('paint', (event: any) => resolve(event.defer()));
+      });
+      w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+      const done = await deferred;
+
+      let painted = false;
+      const onPaint = () => { painted = true; };
+      w.webContents.on('paint', onPaint);
+      await setTimeout(500);
+      w.webContents.off('paint', onPaint);
+      expect(painted).to.be.false('painted while a frame was in flight');
+
+      const nextPaint = once(w.webContents, 'paint');
+      done();
+      const [next] = await nextPaint;
+      expect(next.droppedFrames).to.be.greaterThan(0);
+
+      const metrics = w.webContents.getPaintMetrics();
+      expect(metrics.paintCount).to.be.at.least(2);
+      expect(metrics.droppedFrames).to.be.at.least(next.droppedFrames);
+      expect(metrics.maxLatency).to.be.at.least(500);
+    });
+  });
+
   describe('"transparent" option', () => {
     afterEach(closeAllWindows);
 
@@ -419,6 +419,51 @@ describe('contextBridge', () => {
         expect(result).to.be.true();
       });
 
+      it('should reuse proxies for functions sent across contexts more than once', async () => {
+        await makeBindingWindow(() => {
+          const handler = () => 123;
+          const state = { count: 0 };
+          let lastCallback: Function | null = null;
+          contextBridge.exposeInMainWorld('example', {
+            getHandler: () => handler,
+            getState: () => { state.count++; return state; },
+            isSameCallback: (callback: Function) => {
+              const same = callback === lastCallback;
+              lastCallback = callback;
+              return same;
+            }
+          });
+        });
+        const result = await callWithBindings((root: any) => {
+          const callback = () => {};
+          return [
+            root.example.getHandler() === root.example.getHandler(),
+            root.example.getHandler()(),
+            root.example.isSameCallback(callback),
+            root.example.isSameCallback(callback),
+            root.example.getState().count,
+            root.example.getState().count
+          ];
+        });
+        expect(result).to.deep.equal([true, 123, false, true, 1, 2]);
+      });
+
+      it('should bind proxies to the receiver of each call', async () => {
+        await makeBindingWindow(() => {
+          function getId (this: { id: number }) { return this.id; }
+          let nextId = 0;
+          contextBridge.exposeInMainWorld('example', {
+            create: () => ({ id: nextId++, getId })
+          });
+        });
+        const result = await callWithBindings((root: any) => {
+          const objects = [];
+          for (let i = 0; i < 20; i++) objects.push(root.example.create());
+          return objects.map(object => object.getId());
+        });
+        expect(result).to.deep.equal([...Array(20).keys()]);
+      });
+
       it('should properly handle errors thrown in proxied functions', async () => {
         await makeBindingWindow(() => {
           contextBridge.exposeInMainWorld('example', () => { throw new Error('oh no'); });
@@ -572,6 +617,73 @@ describe('contextBridge', () => {
         expect(result).equal(true);
       });
 
+      it('should copy array buffers and their views', async () => {
+        await makeBindingWindow(() => {
+          const dataView = new DataView(new ArrayBuffer(4));
+          dataView.setUint32(0, 0xdeadbeef);
+          contextBridge.exposeInMainWorld('example', {
+            buffer: Uint8Array.from([1, 2, 3]).buffer,
+            u8: Uint8Array.from([4, 5, 6]),
+            f64: Float64Array.from([1.5, -2]),
+            subarray: Uint16Array.from([1, 2, 3, 4]).subarray(1, 3),
+            dataView
+          });
+        });
+        const result = await callWithBindings((root: any) => {
+          const { buffer, u8, f64, subarray, dataView } = root.example;
+          return [
+            Object.getPrototypeOf(buffer) === ArrayBuffer.prototype,
+            Array.from(new Uint8Array(buffer)),
+            Object.getPrototypeOf(u8) === Uint8Array.prototype,
+            Array.from(u8),
+            Object.getPrototypeOf(f64) === Float64Array.prototype,
+            Array.from(f64),
+            Array.from(subarray),
+            dataView.getUint32(0)
+          ];
+        });
+        expect(result).to.deep.equal([true, [1, 2, 3], true, [4, 5, 6], true, [1.5, -2], [2, 3], 0xdeadbeef]);
+      });
+
+      it('should transfer buffers marked with contextBridge.transfer', async () => {
+        await makeBindingWindow(() => {
+          const u8 = Uint8Array.from([1, 2, 3]);
+          contextBridge.exposeInMainWorld('example', {
+            getBuffer: () => contextBridge.transfer(u8),
+            isDetached: () => u8.byteLength === 0
+          });
+        });
+        const result = await callWithBindings((root: any) => {
+          const u8 = root.example.getBuffer();
+          return [Object.getPrototypeOf(u8) === Uint8Array.prototype, Array.from(u8), root.example.isDetached()];
+        });
+        expect(result).to.deep.equal([true, [1, 2, 3], true]);
+      });
+
+      it('should copy nested objects on first access when exposed lazily', async () => {
+        await makeBindingWindow(() => {
+          const api = {
+            nested: { value: 1, getValue: () => api.nested.value },
+            list: [1, { value: 2 }]
+          };
+          contextBridge.exposeInMainWorld('example', api, { lazy: true });
+          api.nested.value = 3;
+        });
+        const result = await callWithBindings((root: any) => {
+          const { nested, list } = root.example;
+          nested.value = 4;
+          return [
+            nested.value,
+            nested.getValue(),
+            root.example.nested === nested,
+            Object.isFrozen(root.example),
+            Object.isFrozen(nested),
+            list
+          ];
+        });
+        expect(result).to.deep.equal([3, 3, true, true, true, [1, { value: 2 }]]);
+      });
+
       it('should proxy regexps', async () => {
         await makeBindingWindow(() => {
           contextBridge.exposeInMainWorld('example', /a/g);
@@ -93,6 +93,44 @@ describe('ipc main module', () => {
     });
   });
 
+  describe('ipcMain.handleInWorker', () => {
+    const handlerPath = path.join(fixtures, 'api', 'ipc-main-worker', 'handler.js');
+
+    afterEach(() => { ipcMain.removeHandler('worker-handler'); });
+
+    it('runs the handler on a worker thread', async () => {
+      ipcMain.handleInWorker('worker-handler', handlerPath);
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w.loadURL('about:blank');
+      const result = await w.webContents.executeJavaScript("require('electron').ipcRenderer.invoke('worker-handler', 1, 'two')");
+      expect(result.isMainThread).to.be.false();
+      expect(result.args).to.deep.equal([1, 'two']);
+      expect(result.event).to.deep.equal({
+        type: 'frame',
+        processId: w.webContents.getProcessId(),
+        frameId: w.webContents.mainFrame.routingId,
+        url: 'about:blank'
+      });
+    });
+
+    it('rejects the invocation when the handler throws', async () => {
+      ipcMain.handleInWorker('worker-handler', handlerPath);
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w.loadURL('about:blank');
+      await expect(w.webContents.executeJavaScript("require('electron').ipcRenderer.invoke('worker-handler', 'throw')"))
+        .to.eventually.be.rejectedWith(/handler error/);
+    });
+
+    it('throws when a handler is already registered', () => {
+      ipcMain.handle('worker-handler', () => {});
+      expect(() => ipcMain.handleInWorker('worker-handler', handlerPath)).to.throw(/second handler/);
+    });
+
+    it('throws when the module path is not absolute', () => {
+      expect(() => ipcMain.handleInWorker('worker-handler', 'handler.js')).to.throw(/absolute path/);
+    });
+  });
+
   describe('ipcMain.removeAllListeners', () => {
     beforeEach(() => { ipcMain.removeAllListeners(); });
     beforeEach(() => { ipcMain.removeAllListeners(); });
@@ -2,7 +2,7 @@ import { ipcMain, BrowserWindow } from 'electron/main';
 
 import { expect } from 'chai';
 
-import { once } from 'node:events';
+import { on, once } from 'node:events';
 
 import { closeWindow } from './lib/window-helpers';
 
@@ -121,6 +121,85 @@ describe('ipcRenderer module', () => {
       expect(childValue.hello).to.equal('world');
       expect(childValue.child).to.equal(childValue);
     });
+
+    it('preserves primitives, strings, arrays and plain objects', async () => {
+      w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        const sparse = [1, , 3]
+        const named = [1, 2]
+        named.extra = 'value'
+        ipcRenderer.send('message', 42, -7, -0, 1.5, NaN, 2 ** 40, true, null, undefined, '', 'hello', 'h\\u00e9llo \\u2603 \\ud83d',
+          { a: [1, { b: 'c' }], 1: 'one' }, sparse, named)
+      }`);
+
+      const [, ...values] = await once(ipcMain, 'message');
+      const [sparse, named] = values.splice(-2);
+      expect(values).to.deep.equal([42, -7, -0, 1.5, NaN, 2 ** 40, true, null, undefined, '', 'hello', 'héllo ☃ \ud83d',
+        { a: [1, { b: 'c' }], 1: 'one' }]);
+      expect(Object.is(values[2], -0)).to.be.true();
+      expect(1 in sparse).to.be.false();
+      expect(sparse).to.have.lengthOf(3);
+      expect(named.extra).to.equal('value');
+    });
+
+    it('throws on objects that can not be cloned', async () => {
+      const errors = await w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        const values = [new WeakRef({}), new FinalizationRegistry(() => {}), [1, 2][Symbol.iterator](),
+          'abc'[Symbol.iterator](), new Map().entries(), new Intl.Collator()]
+        values.map(value => {
+          try {
+            ipcRenderer.send('message', { value })
+            return null
+          } catch (error) {
+            return error.message
+          }
+        })
+      }`);
+      for (const error of errors) {
+        expect(error).to.match(/could not be cloned/);
+      }
+    });
+
+    it('runs each getter once', async () => {
+      const calls = w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        let calls = 0
+        const value = {
+          get counted () {
+            calls++
+            return 'counted'
+          },
+          date: new Date(0)
+        }
+        ipcRenderer.send('message', value, [value.date, { get counted () { calls++; return 1 } }])
+        calls
+      }`);
+
+      const [, value, array] = await once(ipcMain, 'message');
+      expect(value.counted).to.equal('counted');
+      expect(value.date.getTime()).to.equal(0);
+      expect(array[1].counted).to.equal(1);
+      expect(await calls).to.equal(2);
+    });
+  });
+
+  describe('sendBatched()', () => {
+    it('delivers messages in order with the ones sent by send()', async () => {
+      w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.sendBatched('batched-message', 1)
+        ipcRenderer.sendBatched('batched-message', 2, { three: 3 })
+        ipcRenderer.send('batched-message', 4)
+        ipcRenderer.sendBatched('batched-message', 5)
+      }`);
+      const received: any[] = [];
+      for await (const [, ...args] of on(ipcMain, 'batched-message')) {
+        received.push(args);
+        if (received.length === 4) break;
+      }
+      expect(received).to.deep.equal([[1], [2, { three: 3 }], [4], [5]]);
+    });
   });
 
   describe('sendSync()', () => {
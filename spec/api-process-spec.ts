@@ -35,6 +35,19 @@ describe('process module', () => {
       });
     });
 
+    describe('process.getUvRunMetrics()', () => {
+      it('counts the work done to run the event loop', async () => {
+        const metrics = await invoke(async () => {
+          await new Promise(resolve => setTimeout(resolve, 10));
+          return process.getUvRunMetrics();
+        });
+        expect(metrics.wakeups).to.be.a('number').and.be.at.least(1);
+        expect(metrics.iterations).to.be.at.least(metrics.wakeups);
+        expect(metrics.wakeupsOverBudget).to.be.at.most(metrics.wakeups);
+        expect(metrics.runTime).to.be.a('number').and.be.at.least(0);
+      });
+    });
+
     describe('process.getProcessMemoryInfo()', () => {
       it('resolves promise successfully with valid data', async () => {
         const memoryInfo = await invoke(() => process.getProcessMemoryInfo());
@@ -301,6 +301,123 @@ describe('webFrameMain module', () => {
     });
   });
 
+  describe('WebFrame.createSharedRingBuffer', () => {
+    const v8Util = process._linkedBinding('electron_common_v8_util');
+
+    it('passes bytes in both directions', async () => {
+      const w = new BrowserWindow({
+        show: false,
+        webPreferences: { nodeIntegration: true, contextIsolation: false }
+      });
+      await w.loadURL('about:blank');
+      await w.webContents.executeJavaScript(`
+        require('electron').ipcRenderer.on('ring', (event, ring) => {
+          ring.on('readable', () => {
+            let data;
+            while ((data = ring.read()) !== null) {
+              ring.write(data.reverse());
+            }
+          });
+        });
+      `);
+
+      const ring = w.webContents.mainFrame.createSharedRingBuffer('ring', { capacity: 4096 });
+      expect(ring.capacity).to.equal(4096);
+      const readable = once(ring, 'readable');
+      expect(ring.write(new Uint8Array([1, 2, 3]))).to.be.true();
+      await readable;
+      expect([...ring.read()!]).to.deep.equal([3, 2, 1]);
+      expect(ring.read()).to.be.null();
+    });
+
+    it('reports when a full ring has space again', async () => {
+      const w = new BrowserWindow({
+        show: false,
+        webPreferences: { nodeIntegration: true, contextIsolation: false }
+      });
+      await w.loadURL('about:blank');
+      await w.webContents.executeJavaScript(`
+        require('electron').ipcRenderer.on('ring', (event, ring) => {
+          window.ring = ring;
+        });
+      `);
+
+      const ring = w.webContents.mainFrame.createSharedRingBuffer('ring', { capacity: 4096 });
+      const data = new Uint8Array(1020);
+      for (let i = 0; i < 4; i++) {
+        expect(ring.write(data)).to.be.true();
+      }
+      expect(ring.write(data)).to.be.false();
+
+      const writable = once(ring, 'writable');
+      await waitUntil(() => w.webContents.executeJavaScript('!!window.ring'));
+      expect(await w.webContents.executeJavaScript('window.ring.read().length')).to.equal(1020);
+      await writable;
+      expect(ring.write(data)).to.be.true();
+    });
+
+    it('throws for data larger than the ring', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      const ring = w.webContents.mainFrame.createSharedRingBuffer('ring', { capacity: 4096 });
+      expect(() => ring.write(new Uint8Array(4096))).to.throw(/larger than the ring buffer/);
+    });
+
+    it('emits close when the other side closes', async () => {
+      const w = new BrowserWindow({
+        show: false,
+        webPreferences: { nodeIntegration: true, contextIsolation: false }
+      });
+      await w.loadURL('about:blank');
+      await w.webContents.executeJavaScript(`
+        require('electron').ipcRenderer.on('ring', (event, ring) => ring.close());
+      `);
+      const ring = w.webContents.mainFrame.createSharedRingBuffer('ring');
+      expect(ring.capacity).to.equal(1024 * 1024);
+      await once(ring, 'close');
+      expect(ring.read()).to.be.null();
+    });
+
+    it('stays open when only referenced by its listeners', async () => {
+      const w = new BrowserWindow({
+        show: false,
+        webPreferences: { nodeIntegration: true, contextIsolation: false }
+      });
+      await w.loadURL('about:blank');
+      await w.webContents.executeJavaScript(`
+        require('electron').ipcRenderer.on('ring', (event, ring) => {
+          ring.on('readable', () => {
+            let data;
+            while ((data = ring.read()) !== null) {
+              ring.write(data);
+            }
+          });
+        });
+      `);
+
+      let ring: ReturnType<WebFrameMain['createSharedRingBuffer']> | null =
+        w.webContents.mainFrame.createSharedRingBuffer('ring', { capacity: 4096 });
+      const readable = once(ring, 'readable');
+      const closed = once(ring, 'close');
+      const ringRef = new WeakRef(ring);
+      ring = null;
+      await w.webContents.executeJavaScript(
+        "process._linkedBinding('electron_common_v8_util').requestGarbageCollectionForTesting()");
+      v8Util.requestGarbageCollectionForTesting();
+      await setTimeout();
+
+      expect(ringRef.deref()).to.not.be.undefined();
+      expect(ringRef.deref()!.write(new Uint8Array([1, 2, 3]))).to.be.true();
+      await readable;
+      expect([...ringRef.deref()!.read()!]).to.deep.equal([1, 2, 3]);
+
+      // Navigating away releases the renderer's side, which closes the
+      // channel.
+      await w.loadURL('about:blank');
+      await closed;
+    });
+  });
+
   describe('RenderFrame lifespan', () => {
     let server: Awaited<ReturnType<typeof createServer>>;
     let w: BrowserWindow;
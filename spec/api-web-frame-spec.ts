@@ -174,6 +174,18 @@ describe('webFrame module', () => {
       });
     });
 
+    describe('routingId', () => {
+      it('matches the routing ID of the WebFrameMain', async () => {
+        const routingIds = await w.executeJavaScript('[webFrame.routingId, childFrame.routingId]');
+        expect(routingIds).to.deep.equal([w.mainFrame.routingId, w.mainFrame.frames[0].routingId]);
+      });
+
+      it('can be used to find the frame', async () => {
+        const equal = await w.executeJavaScript('isSameWebFrame(webFrame.findFrameByRoutingId(childFrame.routingId), childFrame)');
+        expect(equal).to.be.true();
+      });
+    });
+
     describe('setZoomFactor()', () => {
       it('works', async () => {
         const zoom = await w.executeJavaScript('childFrame.setZoomFactor(2.0); childFrame.getZoomFactor()');
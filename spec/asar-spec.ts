@@ -1,9 +1,11 @@
-import { BrowserWindow, ipcMain } from 'electron/main';
+import { BrowserWindow, ipcMain, net } from 'electron/main';
 
 import { expect } from 'chai';
 
+import * as cp from 'node:child_process';
 import { once } from 'node:events';
 import * as importedFs from 'node:fs';
+import * as os from 'node:os';
 import * as path from 'node:path';
 import * as url from 'node:url';
 import { Worker } from 'node:worker_threads';
@@ -85,6 +87,17 @@ describe('asar package', () => {
         throw new Error(error);
       }
     });
+
+    it('serves byte ranges of packed files', async () => {
+      const fileUrl = url.pathToFileURL(path.join(asarDir, 'web.asar', 'index.html')).toString();
+      const response = await net.fetch(fileUrl);
+      expect(response.headers.get('content-type')).to.equal('text/html');
+      const body = await response.text();
+      expect(body).to.equal(importedFs.readFileSync(path.join(asarDir, 'web.asar', 'index.html'), 'utf8'));
+
+      const partial = await net.fetch(fileUrl, { headers: { Range: 'bytes=2-5' } });
+      expect(await partial.text()).to.equal(body.slice(2, 6));
+    });
   });
 
   describe('worker', () => {
@@ -115,6 +128,165 @@ describe('asar package', () => {
     });
   });
 
+  describe('precompiled header index', () => {
+    let tmpDir: string;
+    let archive: string;
+
+    beforeEach(async () => {
+      tmpDir = await importedFs.promises.mkdtemp(path.join(os.tmpdir(), 'electron-asar-index-'));
+      archive = path.join(tmpDir, 'a.asar');
+      await importedFs.promises.copyFile(path.join(asarDir, 'a.asar'), archive);
+    });
+
+    afterEach(async () => {
+      await importedFs.promises.rm(tmpDir, { force: true, recursive: true });
+    });
+
+    const readArchive = (env: Record<string, string> = {}) => {
+      const script = `
+        const fs = require('node:fs');
+        const path = require('node:path');
+        const archive = ${JSON.stringify(archive)};
+        console.log(JSON.stringify({
+          file1: fs.readFileSync(path.join(archive, 'file1'), 'utf8').trim(),
+          link2: fs.readFileSync(path.join(archive, 'link2', 'link2', 'file1'), 'utf8').trim(),
+          dir1: fs.readdirSync(path.join(archive, 'dir1')),
+          isDirectory: fs.statSync(path.join(archive, 'dir2')).isDirectory()
+        }));
+      `;
+      const { stdout } = cp.spawnSync(process.execPath, ['-e', script], {
+        env: { ...process.env, ELECTRON_RUN_AS_NODE: '1', ...env }
+      });
+      return JSON.parse(stdout.toString());
+    };
+
+    it('is only written when requested', () => {
+      readArchive();
+      expect(importedFs.existsSync(`${archive}.index`)).to.be.false();
+      readArchive({ ELECTRON_GENERATE_ASAR_INDEX: '1' });
+      expect(importedFs.existsSync(`${archive}.index`)).to.be.true();
+    });
+
+    it('resolves entries like the JSON header', () => {
+      const expected = readArchive({ ELECTRON_GENERATE_ASAR_INDEX: '1' });
+      expect(expected).to.deep.equal({
+        file1: 'file1',
+        link2: 'file1',
+        dir1: ['file1', 'file2', 'file3', 'link1', 'link2'],
+        isDirectory: true
+      });
+      expect(readArchive()).to.deep.equal(expected);
+    });
+
+    it('ignores a stale index', async () => {
+      readArchive({ ELECTRON_GENERATE_ASAR_INDEX: '1' });
+      await importedFs.promises.copyFile(path.join(asarDir, 'empty.asar'), archive);
+      const { status } = cp.spawnSync(process.execPath, ['-e', `
+        const fs = require('node:fs');
+        process.exit(fs.readFileSync(${JSON.stringify(path.join(archive, 'file1'))}, 'utf8') === '' ? 0 : 1);
+      `], { env: { ...process.env, ELECTRON_RUN_AS_NODE: '1' } });
+      expect(status).to.equal(0);
+    });
+  });
+
+  describe('startup read-ahead trace', () => {
+    let tmpDir: string;
+    let archive: string;
+
+    beforeEach(async () => {
+      tmpDir = await importedFs.promises.mkdtemp(path.join(os.tmpdir(), 'electron-asar-trace-'));
+      archive = path.join(tmpDir, 'a.asar');
+      await importedFs.promises.copyFile(path.join(asarDir, 'a.asar'), archive);
+    });
+
+    afterEach(async () => {
+      await importedFs.promises.rm(tmpDir, { force: true, recursive: true });
+    });
+
+    const readArchive = (env: Record<string, string> = {}) => {
+      const script = `
+        const fs = require('node:fs');
+        const path = require('node:path');
+        const archive = ${JSON.stringify(archive)};
+        console.log(JSON.stringify([
+          fs.readFileSync(path.join(archive, 'file1'), 'utf8').trim(),
+          fs.readFileSync(path.join(archive, 'dir1', 'file2'), 'utf8').trim()
+        ]));
+      `;
+      const { pid, stdout } = cp.spawnSync(process.execPath, ['-e', script], {
+        env: { ...process.env, ELECTRON_RUN_AS_NODE: '1', ...env }
+      });
+      return { pid, contents: JSON.parse(stdout.toString()) };
+    };
+
+    const readTraces = () => Object.fromEntries(importedFs.readdirSync(tmpDir)
+      .filter(name => name.endsWith('.trace'))
+      .map(name => [name, importedFs.readFileSync(path.join(tmpDir, name))]));
+
+    it('records each process into its own trace', () => {
+      const first = readArchive({ ELECTRON_RECORD_ASAR_TRACE: '60' });
+      const second = readArchive({ ELECTRON_RECORD_ASAR_TRACE: '60' });
+      const traces = readTraces();
+      expect(Object.keys(traces)).to.have.members([
+        `a.asar.browser.${first.pid}.trace`,
+        `a.asar.browser.${second.pid}.trace`
+      ]);
+      for (const trace of Object.values(traces)) {
+        // A 24 byte header followed by the 16 byte ranges that were read.
+        expect(trace.readUInt32LE(0)).to.equal(0x54525341);
+        expect(trace.length).to.be.greaterThan(24);
+        expect((trace.length - 24) % 16).to.equal(0);
+      }
+    });
+
+    it('replays recorded traces without changing them', () => {
+      const recorded = readArchive({ ELECTRON_RECORD_ASAR_TRACE: '60' });
+      expect(recorded.contents).to.deep.equal(['file1', 'file2']);
+      const traces = readTraces();
+      expect(readArchive().contents).to.deep.equal(recorded.contents);
+      expect(readTraces()).to.deep.equal(traces);
+    });
+
+    it('ignores malformed traces', async () => {
+      readArchive({ ELECTRON_RECORD_ASAR_TRACE: '60' });
+      const [trace] = Object.values(readTraces());
+      await importedFs.promises.writeFile(path.join(tmpDir, 'a.asar.browser.1.trace'), 'not a trace');
+      // A range past the end of the archive.
+      const outOfRange = Buffer.concat([trace.subarray(0, 24), Buffer.alloc(16, 0xff)]);
+      await importedFs.promises.writeFile(path.join(tmpDir, 'a.asar.browser.2.trace'), outOfRange);
+      expect(readArchive().contents).to.deep.equal(['file1', 'file2']);
+    });
+  });
+
+  describe('statBatch', () => {
+    const { Archive } = process._linkedBinding('electron_common_asar');
+
+    it('packs the type, size and offset of each path', () => {
+      const archive = new Archive(path.join(asarDir, 'a.asar'));
+      const paths = ['file1', 'dir1', 'dir1/file2', 'link1', 'ping.js'];
+      const stats = archive.statBatch(paths) as Float64Array;
+      expect(stats).to.be.an.instanceOf(Float64Array);
+      expect(stats).to.have.lengthOf(paths.length * 3);
+      paths.forEach((filePath, i) => {
+        const { type, size, offset } = archive.stat(filePath) as NodeJS.AsarFileStat;
+        expect(Array.from(stats.subarray(i * 3, i * 3 + 3))).to.deep.equal([type, size, offset]);
+      });
+      expect(stats[2 * 3 + 1]).to.equal(6);
+    });
+
+    it('reports missing entries with a type of -1', () => {
+      const archive = new Archive(path.join(asarDir, 'a.asar'));
+      const stats = archive.statBatch(['file1', 'not-exist', 'dir1/not-exist']) as Float64Array;
+      expect(stats[0]).to.be.at.least(0);
+      expect(Array.from(stats.subarray(3))).to.deep.equal([-1, 0, 0, -1, 0, 0]);
+    });
+
+    it('returns an empty array for no paths', () => {
+      const archive = new Archive(path.join(asarDir, 'a.asar'));
+      expect(archive.statBatch([])).to.have.lengthOf(0);
+    });
+  });
+
   describe('worker threads', function () {
     // DISABLED-FIXME(#38192): only disabled for ASan.
     ifit(!process.env.IS_ASAN)('should start worker thread from asar file', function (callback) {
@@ -225,6 +397,16 @@ describe('asar package', function () {
         expect(fs.readFileSync(p2).toString().trim()).to.equal('file1');
       });
 
+      itremote('gives up on cyclic links', function () {
+        // 'a' links to 'a/b', which can only be resolved by resolving 'a'.
+        const p = path.join(asarDir, 'cyclic-link.asar', 'a', 'b', 'file1');
+        expect(() => {
+          fs.readFileSync(p);
+        }).to.throw(/ENOENT/);
+        expect(fs.existsSync(p)).to.be.false();
+        expect(fs.existsSync(path.join(asarDir, 'cyclic-link.asar', 'file1'))).to.be.true();
+      });
+
       itremote('throws ENOENT error when can not find file', function () {
         const p = path.join(asarDir, 'a.asar', 'not-exist');
         expect(() => {
@@ -0,0 +1,8 @@
+const { isMainThread } = require('node:worker_threads');
+
+module.exports = (event, ...args) => {
+  if (args[0] === 'throw') {
+    throw new Error('handler error');
+  }
+  return { isMainThread, event, args };
+};
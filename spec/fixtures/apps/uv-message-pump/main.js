@@ -0,0 +1,26 @@
+const { app } = require('electron');
+
+const fs = require('node:fs');
+const net = require('node:net');
+const { setImmediate, setTimeout } = require('node:timers/promises');
+
+// Exercises timers, immediates, the thread pool and sockets once the libuv
+// loop is run from the message pump.
+app.whenReady().then(async () => {
+  await setTimeout(10);
+  await setImmediate();
+  await fs.promises.readFile(__filename);
+
+  const server = net.createServer(socket => socket.pipe(socket));
+  await new Promise(resolve => server.listen(0, '127.0.0.1', resolve));
+  const echoed = await new Promise((resolve, reject) => {
+    const socket = net.connect(server.address().port, '127.0.0.1', () => socket.end('ping'));
+    let data = '';
+    socket.on('data', chunk => { data += chunk; });
+    socket.on('end', () => resolve(data));
+    socket.on('error', reject);
+  });
+  server.close();
+
+  app.exit(echoed === 'ping' ? 0 : 1);
+}).catch(() => app.exit(1));
@@ -213,6 +213,15 @@ describe('node feature', () => {
     expect(code).to.equal(0);
   });
 
+  ifit(process.platform === 'linux')('runs libuv from the message pump with UvMessagePumpIntegration', async () => {
+    const appPath = path.join(mainFixturesPath, 'apps', 'uv-message-pump', 'main.js');
+    const appProcess = childProcess.spawn(process.execPath, ['--enable-features=UvMessagePumpIntegration', appPath], {
+      stdio: 'inherit'
+    });
+    const [code] = await once(appProcess, 'close');
+    expect(code).to.equal(0);
+  });
+
   describe('contexts', () => {
     describe('setTimeout called under Chromium event loop in browser process', () => {
       it('Can be scheduled in time', (done) => {
@@ -25,6 +25,7 @@ declare namespace NodeJS {
 
   interface IpcRendererImpl {
     send(internal: boolean, channel: string, args: any[]): void;
+    sendBatched(channel: string, args: any[]): void;
     sendSync(internal: boolean, channel: string, args: any[]): any;
     sendToHost(channel: string, args: any[]): void;
     invoke<T>(internal: boolean, channel: string, args: any[]): Promise<{ error: string, result: T }>;
@@ -80,9 +81,11 @@ declare namespace NodeJS {
   interface AsarArchive {
     getFileInfo(path: string): AsarFileInfo | false;
     stat(path: string): AsarFileStat | false;
+    statBatch(paths: string[]): Float64Array | false;
     readdir(path: string): string[] | false;
     realpath(path: string): string | false;
     copyFileOut(path: string): string | false;
+    read(path: string, utf8: boolean): Buffer | string | false;
     getFdAndValidateIntegrityLater(): number | -1;
   }
 
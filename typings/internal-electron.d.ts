@@ -132,6 +132,7 @@ declare namespace Electron {
     _send(internal: boolean, channel: string, args: any): void;
     _sendInternal(channel: string, ...args: any[]): void;
     _postMessage(channel: string, message: any, transfer?: any[]): void;
+    _createSharedRingBuffer(channel: string, capacity: number): any;
     _lifecycleStateForTesting: string;
   }
 
@@ -358,9 +359,15 @@ declare namespace ElectronInternal {
     static create(opts?: Electron.WebPreferences): Electron.WebContents;
   }
 
+  // A sync IPC call and its result: [channel, args, result].
+  type SyncCacheEntry = [string, any[], any];
+
   interface PreloadScript extends Electron.PreloadScript {
     contents?: string;
     error?: Error;
+    // Set when the browser keeps a V8 code cache for the preload.
+    sourceHash?: string;
+    cachedData?: Uint8Array;
   }
 }
 